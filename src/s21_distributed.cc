@@ -0,0 +1,250 @@
+#include "s21_distributed.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Global indices of the block-cyclic tiles owned by coordinate `coord` out
+// of `procs` along a dimension of length n
+std::vector<int> Owned(int n, int block, int procs, int coord) {
+  std::vector<int> result;
+  for (int start = coord * block; start < n; start += procs * block) {
+    for (int i = start; i < std::min(n, start + block); i++) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+// Position of each global index in `owned`, -1 if not owned
+std::vector<int> LocalIndex(int n, const std::vector<int>& owned) {
+  std::vector<int> result(n, -1);
+  for (int i = 0; i < int(owned.size()); i++) result[owned[i]] = i;
+  return result;
+}
+
+}  // namespace
+
+S21ProcessGroup::S21ProcessGroup(int workers)
+    : workers_(workers), barrier_(NULL) {
+  if (workers <= 0) {
+    throw std::runtime_error(
+        "Error: The number of workers must be greater than zero");
+  }
+}
+
+void S21ProcessGroup::Run(size_t bytes,
+                          const std::function<void(char*)>& scatter,
+                          const std::function<void(int, char*)>& job,
+                          const std::function<void(const char*)>& gather) {
+  // The barrier lives at the start of the mapping, aligned for doubles after
+  size_t header = (sizeof(pthread_barrier_t) + 63) / 64 * 64;
+  size_t total = header + bytes;
+  void* memory = mmap(NULL, total, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    throw std::runtime_error("Error: Failed to map shared memory");
+  }
+  char* shared = static_cast<char*>(memory) + header;
+  barrier_ = static_cast<pthread_barrier_t*>(memory);
+  pthread_barrierattr_t attr;
+  pthread_barrierattr_init(&attr);
+  pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_barrier_init(barrier_, &attr, unsigned(workers_));
+  pthread_barrierattr_destroy(&attr);
+
+  bool ok = true;
+  try {
+    scatter(shared);
+  } catch (...) {
+    pthread_barrier_destroy(barrier_);
+    munmap(memory, total);
+    barrier_ = NULL;
+    throw;
+  }
+
+  // Workers share one process group, so they can be reaped in exit order
+  // and killed together
+  pid_t group = 0;
+  int started = 0;
+  for (int rank = 0; rank < workers_; rank++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      setpgid(0, group);
+      int status = 0;
+      try {
+        job(rank, shared);
+      } catch (...) {
+        status = 1;
+      }
+      _exit(status);
+    }
+    if (pid < 0) {
+      ok = false;
+      break;
+    }
+    setpgid(pid, group);
+    if (group == 0) group = pid;
+    started++;
+  }
+  // Peers of a worker that failed or never started would wait on the
+  // barrier forever
+  if (!ok && started > 0) kill(-group, SIGKILL);
+  while (started > 0) {
+    int status = 0;
+    if (waitpid(-group, &status, 0) < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    started--;
+    if (ok && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+      ok = false;
+      kill(-group, SIGKILL);
+    }
+  }
+
+  // A worker killed inside Barrier() never leaves it, and destroying the
+  // barrier would wait for it forever; unmapping is enough in that case
+  if (ok) pthread_barrier_destroy(barrier_);
+  try {
+    if (ok) gather(shared);
+  } catch (...) {
+    ok = false;
+  }
+  munmap(memory, total);
+  barrier_ = NULL;
+  if (!ok) {
+    throw std::runtime_error("Error: A worker process failed");
+  }
+}
+
+void S21ProcessGroup::Barrier() const { pthread_barrier_wait(barrier_); }
+
+S21Matrix DistributedMulMatrix(const S21Matrix& a, const S21Matrix& b,
+                               int grid_rows, int grid_cols, int block) {
+  if (a.cols() != b.rows()) {
+    throw std::runtime_error(
+        "Number of columns in the first matrix should match number of rows in "
+        "the second matrix.");
+  }
+  if (grid_rows <= 0 || grid_cols <= 0 || block <= 0) {
+    throw std::runtime_error("Error: Invalid process grid");
+  }
+  int m = a.rows(), k = a.cols(), n = b.cols();
+
+  // Shared layout: inputs, the current A and B panels, the gathered product
+  size_t offset_b = size_t(m) * k;
+  size_t offset_panel_a = offset_b + size_t(k) * n;
+  size_t offset_panel_b = offset_panel_a + size_t(m) * block;
+  size_t offset_c = offset_panel_b + size_t(block) * n;
+  size_t total = offset_c + size_t(m) * n;
+
+  S21Matrix result(m, n);
+  S21ProcessGroup group(grid_rows * grid_cols);
+
+  auto scatter = [&](char* shared) {
+    double* shared_a = reinterpret_cast<double*>(shared);
+    for (int i = 0; i < m; i++) {
+      std::memcpy(shared_a + size_t(i) * k, a.row(i), sizeof(double) * k);
+    }
+    for (int i = 0; i < k; i++) {
+      std::memcpy(shared_a + offset_b + size_t(i) * n, b.row(i),
+                  sizeof(double) * n);
+    }
+  };
+
+  auto job = [&](int rank, char* shared) {
+    const double* in_a = reinterpret_cast<double*>(shared);
+    const double* in_b = in_a + offset_b;
+    double* panel_a = reinterpret_cast<double*>(shared) + offset_panel_a;
+    double* panel_b = reinterpret_cast<double*>(shared) + offset_panel_b;
+    double* out_c = reinterpret_cast<double*>(shared) + offset_c;
+    int prow = rank / grid_cols, pcol = rank % grid_cols;
+
+    // Take this worker's tiles out of the shared inputs
+    std::vector<int> rows_a = Owned(m, block, grid_rows, prow);
+    std::vector<int> cols_a = Owned(k, block, grid_cols, pcol);
+    std::vector<int> rows_b = Owned(k, block, grid_rows, prow);
+    std::vector<int> cols_b = Owned(n, block, grid_cols, pcol);
+    std::vector<int> local_col_a = LocalIndex(k, cols_a);
+    std::vector<int> local_row_b = LocalIndex(k, rows_b);
+    std::vector<double> local_a(rows_a.size() * cols_a.size());
+    std::vector<double> local_b(rows_b.size() * cols_b.size());
+    std::vector<double> local_c(rows_a.size() * cols_b.size(), 0.0);
+    for (size_t i = 0; i < rows_a.size(); i++) {
+      for (size_t j = 0; j < cols_a.size(); j++) {
+        local_a[i * cols_a.size() + j] =
+            in_a[size_t(rows_a[i]) * k + cols_a[j]];
+      }
+    }
+    for (size_t i = 0; i < rows_b.size(); i++) {
+      for (size_t j = 0; j < cols_b.size(); j++) {
+        local_b[i * cols_b.size() + j] =
+            in_b[size_t(rows_b[i]) * n + cols_b[j]];
+      }
+    }
+
+    for (int start = 0; start < k; start += block) {
+      int width = std::min(block, k - start);
+      int owner_col = (start / block) % grid_cols;
+      int owner_row = (start / block) % grid_rows;
+      // Publish: A(:, panel) from its process column, B(panel, :) from its
+      // process row
+      if (pcol == owner_col) {
+        for (size_t i = 0; i < rows_a.size(); i++) {
+          const double* src =
+              local_a.data() + i * cols_a.size() + local_col_a[start];
+          std::memcpy(panel_a + size_t(rows_a[i]) * block, src,
+                      sizeof(double) * width);
+        }
+      }
+      if (prow == owner_row) {
+        for (int kk = 0; kk < width; kk++) {
+          const double* src =
+              local_b.data() + local_row_b[start + kk] * cols_b.size();
+          double* dst = panel_b + size_t(kk) * n;
+          for (size_t j = 0; j < cols_b.size(); j++) dst[cols_b[j]] = src[j];
+        }
+      }
+      group.Barrier();
+      for (size_t i = 0; i < rows_a.size(); i++) {
+        const double* pa = panel_a + size_t(rows_a[i]) * block;
+        double* c = local_c.data() + i * cols_b.size();
+        for (int kk = 0; kk < width; kk++) {
+          const double* pb = panel_b + size_t(kk) * n;
+          for (size_t j = 0; j < cols_b.size(); j++) {
+            c[j] += pa[kk] * pb[cols_b[j]];
+          }
+        }
+      }
+      group.Barrier();
+    }
+
+    for (size_t i = 0; i < rows_a.size(); i++) {
+      for (size_t j = 0; j < cols_b.size(); j++) {
+        out_c[size_t(rows_a[i]) * n + cols_b[j]] =
+            local_c[i * cols_b.size() + j];
+      }
+    }
+  };
+
+  auto gather = [&](const char* shared) {
+    const double* in_c = reinterpret_cast<const double*>(shared) + offset_c;
+    for (int i = 0; i < m; i++) {
+      std::memcpy(result.mutable_row(i), in_c + size_t(i) * n,
+                  sizeof(double) * n);
+    }
+  };
+
+  group.Run(total * sizeof(double), scatter, job, gather);
+  return result;
+}
@@ -0,0 +1,50 @@
+#ifndef S21_DISTRIBUTED_H_
+#define S21_DISTRIBUTED_H_
+
+// Multi-process execution on one host. Workers are forked processes that
+// communicate through an anonymous shared mapping (POSIX only).
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <functional>
+
+#include "s21_matrix_oop.h"
+
+// Coordinator for block-parallel jobs: prepares a shared region, forks the
+// workers, waits for them and reads the results back.
+class S21ProcessGroup {
+ public:
+  explicit S21ProcessGroup(int workers);
+
+  int workers() const { return workers_; }
+
+  // scatter(shared) runs in the coordinator on a zeroed region of `bytes`
+  // bytes, then every worker runs job(rank, shared) in its own process, then
+  // gather(shared) runs in the coordinator. Throws if any worker throws,
+  // crashes or is killed; gather is skipped in that case.
+  //
+  // Workers are forked from the calling thread only, so job must not rely
+  // on other threads of the coordinator (e.g. S21Executor).
+  void Run(size_t bytes, const std::function<void(char*)>& scatter,
+           const std::function<void(int, char*)>& job,
+           const std::function<void(const char*)>& gather);
+
+  // Blocks until every worker of the running job reaches it; call only
+  // from job
+  void Barrier() const;
+
+ private:
+  int workers_;
+  pthread_barrier_t* barrier_;
+};
+
+// this = a * b computed SUMMA-style on a grid_rows x grid_cols grid of worker
+// processes. a, b and the product are distributed block-cyclically in
+// block x block tiles; for each panel of the inner dimension the owners
+// publish their part of it and every worker updates its own tiles of the
+// product, which are gathered at the end.
+S21Matrix DistributedMulMatrix(const S21Matrix& a, const S21Matrix& b,
+                               int grid_rows, int grid_cols, int block = 64);
+
+#endif  // S21_DISTRIBUTED_H_
@@ -0,0 +1,106 @@
+#ifndef S21_ELEMENTWISE_H_
+#define S21_ELEMENTWISE_H_
+
+// Element-wise kernels over user callables. Each one is a single pass over
+// the contiguous element block that f inlines into, with no bounds checks,
+// so simple lambdas vectorize. Above kS21ElementwiseParallelMin elements the
+// pass is split across S21Executor::Default(), so f must be safe to call
+// concurrently.
+//
+// Rvalue arguments are updated in place: Map(a + b - c, f) or
+// Zip(a * 2.0, b, f) allocate one matrix for the whole expression.
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_error.h"
+#include "s21_executor.h"
+#include "s21_matrix_oop.h"
+
+inline constexpr size_t kS21ElementwiseParallelMin = 1 << 15;
+
+// Runs body(begin, end) over [0, n), in parallel chunks when n is large
+template <class Body>
+void S21ElementwiseFor(size_t n, Body body) {
+  if (n < kS21ElementwiseParallelMin) {
+    body(size_t(0), n);
+    return;
+  }
+  const size_t chunk = kS21ElementwiseParallelMin / 2;
+  int chunks = int((n + chunk - 1) / chunk);
+  S21Executor::Default().ParallelFor(0, chunks, 1, [&](int begin, int end) {
+    body(begin * chunk, std::min(n, end * chunk));
+  });
+}
+
+// a(i, j) = f(a(i, j)) for every element; returns a
+template <class F>
+S21Matrix& Apply(S21Matrix& a, F f) {
+  if (a.rows() == 0) return a;
+  double* x = a.mutable_row(0);
+  S21ElementwiseFor(size_t(a.rows()) * a.cols(), [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; i++) x[i] = f(x[i]);
+  });
+  return a;
+}
+
+// Matrix of f(a(i, j))
+template <class F>
+S21Matrix Map(const S21Matrix& a, F f) {
+  if (a.rows() == 0) return S21Matrix();
+  S21Matrix result(a.rows(), a.cols());
+  const double* x = a.row(0);
+  double* y = result.mutable_row(0);
+  S21ElementwiseFor(size_t(a.rows()) * a.cols(), [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; i++) y[i] = f(x[i]);
+  });
+  return result;
+}
+
+template <class F>
+S21Matrix Map(S21Matrix&& a, F f) {
+  Apply(a, f);
+  return std::move(a);
+}
+
+inline void S21CheckSameSize(const S21Matrix& a, const S21Matrix& b) {
+  if (a.rows() != b.rows() || a.cols() != b.cols()) {
+    S21_THROW(std::runtime_error(
+        "Error: The matrices must have the same dimensions"));
+  }
+}
+
+// Matrix of f(a(i, j), b(i, j)); throws if the dimensions differ
+template <class F>
+S21Matrix Zip(const S21Matrix& a, const S21Matrix& b, F f) {
+  S21CheckSameSize(a, b);
+  if (a.rows() == 0) return S21Matrix();
+  S21Matrix result(a.rows(), a.cols());
+  const double* x = a.row(0);
+  const double* y = b.row(0);
+  double* z = result.mutable_row(0);
+  S21ElementwiseFor(size_t(a.rows()) * a.cols(), [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; i++) z[i] = f(x[i], y[i]);
+  });
+  return result;
+}
+
+template <class F>
+S21Matrix Zip(S21Matrix&& a, const S21Matrix& b, F f) {
+  S21CheckSameSize(a, b);
+  if (a.rows() == 0) return std::move(a);
+  double* x = a.mutable_row(0);
+  const double* y = b.row(0);
+  S21ElementwiseFor(size_t(a.rows()) * a.cols(), [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; i++) x[i] = f(x[i], y[i]);
+  });
+  return std::move(a);
+}
+
+#endif  // S21_ELEMENTWISE_H_
@@ -0,0 +1,22 @@
+#ifndef S21_ERROR_H_
+#define S21_ERROR_H_
+
+// S21_THROW(error) throws error. Built with -fno-exceptions it prints
+// error.what() and aborts instead, so the throwing API becomes a checked
+// contract and callers are expected to use the noexcept Try* variants.
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define S21_THROW(error) throw error
+#else
+[[noreturn]] inline void S21Abort(const std::exception& error) {
+  std::fprintf(stderr, "%s\n", error.what());
+  std::abort();
+}
+#define S21_THROW(error) S21Abort(error)
+#endif
+
+#endif  // S21_ERROR_H_
@@ -0,0 +1,116 @@
+#include "s21_executor.h"
+
+#include <algorithm>
+#include <exception>
+
+struct S21Executor::Batch {
+  Chunk chunk;
+  const void* body;
+  int begin, end, step;
+  int count;    // Chunks in total
+  int claimed;  // Chunks handed out so far
+  int done;     // Chunks finished
+  std::exception_ptr error;  // First one thrown
+  Batch* next;
+};
+
+S21Executor::S21Executor(int threads) : batches_(nullptr), stop_(false) {
+  if (threads <= 0) threads = int(std::thread::hardware_concurrency());
+  if (threads <= 0) threads = 1;
+  for (int i = 0; i < threads; i++) {
+    workers_.emplace_back(&S21Executor::Work, this);
+  }
+}
+
+// Drains the queue before joining, so every returned future becomes ready
+S21Executor::~S21Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+S21Executor& S21Executor::Default() {
+  static S21Executor executor;
+  return executor;
+}
+
+void S21Executor::Post(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push(std::move(job));
+  }
+  ready_.notify_one();
+}
+
+void S21Executor::RunChunks(int begin, int end, int grain, Chunk chunk,
+                            const void* body) {
+  if (begin >= end) return;
+  if (grain < 1) grain = 1;
+  long long count = (long long)end - begin;
+  long long chunks = std::min<long long>((count + grain - 1) / grain,
+                                         threads() + 1);
+  if (chunks <= 1 || worker_of_ != nullptr) {
+    chunk(body, begin, end);
+    return;
+  }
+  long long step = (count + chunks - 1) / chunks;
+  int parts = int((count + step - 1) / step);
+  Batch batch{chunk, body, begin, end, int(step), parts, 0, 0, nullptr,
+              nullptr};
+  std::unique_lock<std::mutex> lock(mutex_);
+  batch.next = batches_;
+  batches_ = &batch;
+  ready_.notify_all();
+  // The caller works through its own chunks too, then waits for the ones
+  // taken by workers: batch lives on this stack frame
+  while (batch.claimed < batch.count) RunChunk(batch, lock);
+  finished_.wait(lock, [&batch] { return batch.done == batch.count; });
+  lock.unlock();
+  if (batch.error) std::rethrow_exception(batch.error);
+}
+
+void S21Executor::RunChunk(Batch& batch, std::unique_lock<std::mutex>& lock) {
+  int index = batch.claimed++;
+  if (batch.claimed == batch.count) {
+    Batch** link = &batches_;
+    while (*link != &batch) link = &(*link)->next;
+    *link = batch.next;
+  }
+  lock.unlock();
+  long long first = batch.begin + (long long)index * batch.step;
+  int last = int(std::min<long long>(batch.end, first + batch.step));
+  std::exception_ptr error;
+  try {
+    batch.chunk(batch.body, int(first), last);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  lock.lock();
+  if (error && !batch.error) batch.error = error;
+  if (++batch.done == batch.count) finished_.notify_all();
+}
+
+// ParallelFor chunks go before queued tasks: their caller is blocked on them
+void S21Executor::Work() {
+  worker_of_ = this;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    ready_.wait(lock, [this] {
+      return stop_ || batches_ != nullptr || !jobs_.empty();
+    });
+    if (batches_ != nullptr) {
+      RunChunk(*batches_, lock);
+      continue;
+    }
+    if (jobs_.empty()) return;
+    std::function<void()> job = std::move(jobs_.front());
+    jobs_.pop();
+    lock.unlock();
+    job();
+    job = nullptr;  // Captured state is released outside the lock too
+    lock.lock();
+  }
+}
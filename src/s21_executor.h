@@ -0,0 +1,206 @@
+#ifndef S21_EXECUTOR_H_
+#define S21_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_error.h"
+
+// Thrown from a cancellation point once the running task's token is cancelled
+class S21Cancelled : public std::runtime_error {
+ public:
+  S21Cancelled() : std::runtime_error("Error: The operation was cancelled") {}
+};
+
+// Shared cancellation flag. Copies refer to the same flag. The long-running
+// S21Matrix kernels (MulMatrix, CalcComplements, the LU factorization) call
+// ThrowIfCancelled() once per row, so a cancelled task stops early.
+class S21CancelToken {
+ public:
+  S21CancelToken() : state_(std::make_shared<std::atomic<bool>>(false)) {}
+
+  void Cancel() { state_->store(true, std::memory_order_relaxed); }
+  bool cancelled() const { return state_->load(std::memory_order_relaxed); }
+
+  // True if the token of the task running on this thread was cancelled;
+  // always false outside executor tasks
+  static bool CancellationRequested() {
+    return current_ && current_->load(std::memory_order_relaxed);
+  }
+  // Cancellation point: throws S21Cancelled if CancellationRequested()
+  static void ThrowIfCancelled() {
+    if (CancellationRequested()) S21_THROW(S21Cancelled());
+  }
+
+ private:
+  friend class S21Executor;
+  std::shared_ptr<std::atomic<bool>> state_;
+  static inline thread_local const std::atomic<bool>* current_ = nullptr;
+};
+
+// Set once the task behind an S21Future has finished, whether it returned,
+// threw or was cancelled; holds the continuation to start then
+class S21Completion {
+ public:
+  // Runs then() right away if the task is done, else when it finishes
+  void OnDone(std::function<void()> then) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!done_) {
+        then_ = std::move(then);
+        return;
+      }
+    }
+    then();
+  }
+  void Finish() {
+    std::function<void()> then;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+      then.swap(then_);
+    }
+    if (then) then();
+  }
+
+ private:
+  std::mutex mutex_;
+  bool done_ = false;
+  std::function<void()> then_;
+};
+
+// Future of an executor task. Converts to std::future<T>; keep it as an
+// S21Future to chain work onto it with S21Executor::SubmitAfter or Then().
+template <class T>
+class S21Future : public std::future<T> {
+ public:
+  S21Future() = default;
+
+ private:
+  friend class S21Executor;
+  S21Future(std::future<T> future, std::shared_ptr<S21Completion> completion)
+      : std::future<T>(std::move(future)), completion_(std::move(completion)) {}
+
+  std::shared_ptr<S21Completion> completion_;
+};
+
+// Fixed-size FIFO thread pool
+class S21Executor {
+ public:
+  explicit S21Executor(int threads = 0);  // 0: hardware concurrency
+  ~S21Executor();
+  S21Executor(const S21Executor&) = delete;
+  S21Executor& operator=(const S21Executor&) = delete;
+
+  // Process-wide pool shared by the library
+  static S21Executor& Default();
+
+  int threads() const { return int(workers_.size()); }
+
+  // Runs f() on a worker. A task cancelled before it starts never runs; its
+  // future holds S21Cancelled.
+  template <class F>
+  S21Future<std::invoke_result_t<F>> Submit(
+      F f, S21CancelToken token = S21CancelToken()) {
+    auto [result, job] = Package(std::move(f), std::move(token));
+    Post(std::move(job));
+    return std::move(result);
+  }
+
+  // Runs next(previous) on a worker once previous is ready, i.e. holds a
+  // value or an exception, so no worker waits for it. previous may come
+  // from another executor, which then queues next here: this one must
+  // outlive it. Cancellation is as for Submit.
+  template <class T, class G>
+  S21Future<std::invoke_result_t<G, std::future<T>>> SubmitAfter(
+      S21Future<T> previous, G next, S21CancelToken token = S21CancelToken()) {
+    std::shared_ptr<S21Completion> after = std::move(previous.completion_);
+    auto [result, job] = Package(
+        [previous = std::future<T>(std::move(previous)),
+         next = std::move(next)]() mutable {
+          return next(std::move(previous));
+        },
+        std::move(token));
+    if (after) {
+      after->OnDone([this, job = std::move(job)] { Post(job); });
+    } else {
+      Post(std::move(job));
+    }
+    return std::move(result);
+  }
+
+  // Splits [begin, end) into chunks of at least `grain` items, at most one
+  // per worker plus one for the caller, and runs body(chunk_begin,
+  // chunk_end) on them. Returns once every chunk is done; the first
+  // exception thrown by a chunk is rethrown. Runs inline when there is only
+  // one chunk or when called from a worker, so nested calls cannot starve
+  // the pool. Allocates nothing: body is passed by address and the chunks
+  // are handed out from a descriptor on the caller's stack.
+  template <class Body>
+  void ParallelFor(int begin, int end, int grain, const Body& body) {
+    RunChunks(begin, end, grain, &Invoke<Body>, &body);
+  }
+
+ private:
+  // One ParallelFor call, linked into batches_ while it has unclaimed chunks
+  struct Batch;
+  using Chunk = void (*)(const void* body, int begin, int end);
+
+  template <class Body>
+  static void Invoke(const void* body, int begin, int end) {
+    (*static_cast<const Body*>(body))(begin, end);
+  }
+
+  // Wraps f in a task that runs under token and marks its future's
+  // completion; the returned job runs it
+  template <class F>
+  static std::pair<S21Future<std::invoke_result_t<F>>, std::function<void()>>
+  Package(F f, S21CancelToken token) {
+    using R = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<R()>>(
+        [f = std::move(f), token]() mutable -> R {
+          const std::atomic<bool>* parent = S21CancelToken::current_;
+          S21CancelToken::current_ = token.state_.get();
+          struct Restore {
+            const std::atomic<bool>* parent;
+            ~Restore() { S21CancelToken::current_ = parent; }
+          } restore{parent};
+          S21CancelToken::ThrowIfCancelled();
+          return f();
+        });
+    auto completion = std::make_shared<S21Completion>();
+    S21Future<R> result(task->get_future(), completion);
+    return {std::move(result), [task, completion] {
+              (*task)();
+              completion->Finish();
+            }};
+  }
+
+  void RunChunks(int begin, int end, int grain, Chunk chunk, const void* body);
+  // Claims and runs the next chunk of batch; mutex_ is held on entry and exit
+  void RunChunk(Batch& batch, std::unique_lock<std::mutex>& lock);
+  void Post(std::function<void()> job);
+  void Work();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable finished_;  // A batch ran its last chunk
+  Batch* batches_;
+  bool stop_;
+
+  static inline thread_local const S21Executor* worker_of_ = nullptr;
+};
+
+#endif  // S21_EXECUTOR_H_
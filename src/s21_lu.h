@@ -0,0 +1,71 @@
+#ifndef S21_LU_H_
+#define S21_LU_H_
+
+// Partial pivoting LU shared by S21Matrix and S21LuFactorization, so both
+// agree on when a matrix is singular. Header-only: the -fno-exceptions core
+// uses it without linking anything else.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+#include "s21_reduce.h"
+
+enum S21LuStatus {
+  kS21LuRegular,
+  // A pivot fell to rounding level within its column: the determinant is
+  // still the pivot product, but solves would return noise
+  kS21LuIllConditioned,
+  kS21LuSingular,  // An exact zero pivot; the determinant is 0
+  kS21LuCancelled
+};
+
+// True if pivot is within the rounding of n operations on values of
+// magnitude scale, i.e. zero as far as the data can tell
+inline bool S21NegligiblePivot(double pivot, double scale, int n) {
+  return std::fabs(pivot) <= n * DBL_EPSILON * scale;
+}
+
+// Factorizes the n x n row-major block a in place: unit L below the
+// diagonal, U from it. Row i then holds source row permutation[i], and
+// *sign is the sign of the permutation. The pivot of column k is compared
+// with the largest element of that column of the partly reduced matrix, so
+// scaling a row or column does not change the verdict: diag(1e16, 1, 1e-16)
+// is regular, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}} ill-conditioned.
+// cancelled() is polled once per column.
+template <class Cancelled>
+S21LuStatus S21LuFactorize(double* a, int n, int* permutation, int* sign,
+                           Cancelled cancelled) {
+  S21LuStatus status = kS21LuRegular;
+  for (int i = 0; i < n; i++) permutation[i] = i;
+  *sign = 1;
+  for (int k = 0; k < n; k++) {
+    if (cancelled()) return kS21LuCancelled;
+    double* rk = a + size_t(k) * n;
+    int pivot = k + int(S21ArgMaxAbs(rk + k, n - k, n));
+    double* rp = a + size_t(pivot) * n;
+    if (rp[k] == 0.0) {
+      status = kS21LuSingular;
+      continue;
+    }
+    double scale = std::fabs(a[S21ArgMaxAbs(a + k, n, n) * n + k]);
+    if (status == kS21LuRegular && S21NegligiblePivot(rp[k], scale, n)) {
+      status = kS21LuIllConditioned;
+    }
+    if (pivot != k) {
+      std::swap_ranges(rk, rk + n, rp);
+      std::swap(permutation[pivot], permutation[k]);
+      *sign = -*sign;
+    }
+    for (int i = k + 1; i < n; i++) {
+      double* ri = a + size_t(i) * n;
+      double factor = ri[k] / rk[k];
+      ri[k] = factor;
+      for (int j = k + 1; j < n; j++) ri[j] -= factor * rk[j];
+    }
+  }
+  return status;
+}
+
+#endif  // S21_LU_H_
@@ -0,0 +1,60 @@
+#ifndef S21_MATRIX_ASYNC_H_
+#define S21_MATRIX_ASYNC_H_
+
+// Asynchronous S21Matrix operations. Operands are taken by value, so the
+// caller may modify or destroy its own matrices while the task runs. Errors
+// (dimension mismatch, singular matrix, S21Cancelled) are delivered through
+// the future.
+
+#include <future>
+#include <type_traits>
+#include <utility>
+
+#include "s21_executor.h"
+#include "s21_matrix_oop.h"
+
+inline S21Future<S21Matrix> MulMatrixAsync(
+    S21Matrix lhs, S21Matrix rhs, S21CancelToken token = S21CancelToken(),
+    S21Executor& executor = S21Executor::Default()) {
+  return executor.Submit(
+      [lhs = std::move(lhs), rhs = std::move(rhs)]() mutable {
+        lhs.MulMatrix(rhs);
+        return std::move(lhs);
+      },
+      token);
+}
+
+inline S21Future<S21Matrix> InverseMatrixAsync(
+    S21Matrix matrix, S21CancelToken token = S21CancelToken(),
+    S21Executor& executor = S21Executor::Default()) {
+  return executor.Submit(
+      [matrix = std::move(matrix)]() mutable { return matrix.InverseMatrix(); },
+      token);
+}
+
+inline S21Future<double> DeterminantAsync(
+    S21Matrix matrix, S21CancelToken token = S21CancelToken(),
+    S21Executor& executor = S21Executor::Default()) {
+  return executor.Submit(
+      [matrix = std::move(matrix)] { return matrix.Determinant(); }, token);
+}
+
+// Chains next onto previous: the returned future holds next(previous.get()).
+// An exception in previous skips next and is rethrown from the new future.
+// next is queued only once previous is ready, so pending chains hold no
+// worker, e.g.
+//   Then(MulMatrixAsync(a, b, token),
+//        [](S21Matrix m) { return m.InverseMatrix(); }, token);
+template <class T, class F>
+S21Future<std::invoke_result_t<F, T>> Then(
+    S21Future<T> previous, F next, S21CancelToken token = S21CancelToken(),
+    S21Executor& executor = S21Executor::Default()) {
+  return executor.SubmitAfter(
+      std::move(previous),
+      [next = std::move(next)](std::future<T> previous) mutable {
+        return next(previous.get());
+      },
+      token);
+}
+
+#endif  // S21_MATRIX_ASYNC_H_
@@ -0,0 +1,173 @@
+// Benchmark driver for S21Matrix. Used directly for timing and as the
+// training workload of the profile-guided build (make pgo).
+//
+// Usage: ./bench [repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "s21_distributed.h"
+#include "s21_elementwise.h"
+#include "s21_matrix_oop.h"
+#include "s21_reduce.h"
+#include "s21_solvers.h"
+#include "s21_structured.h"
+#include "s21_update.h"
+#include "s21_vector.h"
+
+namespace {
+
+S21Matrix Filled(int size, unsigned seed) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      seed = seed * 1103515245u + 12345u;
+      result(i, j) = double(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+    }
+    result(i, i) += size;  // Diagonally dominant, so always invertible
+  }
+  return result;
+}
+
+void Run(const char* name, int size, int repetitions,
+         const std::function<void()>& body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repetitions; r++) body();
+  double ns = std::chrono::duration<double, std::nano>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+  std::printf("%-16s %6d %14.0f ns/op\n", name, size, ns / repetitions);
+}
+
+S21SparseMatrix Poisson(int size) {
+  std::vector<S21SparseMatrix::Entry> entries;
+  for (int i = 0; i < size; i++) {
+    entries.push_back({i, i, 2.0});
+    if (i > 0) entries.push_back({i, i - 1, -1.0});
+    if (i + 1 < size) entries.push_back({i, i + 1, -1.0});
+  }
+  return S21SparseMatrix(size, entries);
+}
+
+// The modules built on S21Matrix, so that the profile-guided build trains
+// every translation unit. Sizes fall on both sides of the threading
+// threshold, so the executor paths are covered too.
+void RunKernels(int repetitions) {
+  volatile double sink = 0.0;
+  for (int n : {1000, 1 << 17}) {
+    S21Vector x(n, 1.0), y(n, 0.5), solution(n);
+    Run("dot", n, repetitions, [&] { sink = x.Dot(y); });
+    Run("axpy", n, repetitions, [&] { y.Axpy(1e-3, x); });
+
+    S21SparseMatrix a = Poisson(n);
+    S21Ilu0Preconditioner ilu(a);
+    S21JacobiPreconditioner jacobi(a);
+    S21SolverOptions options;
+    options.max_iterations = 50;
+    S21ConjugateGradient cg(options);
+    S21Gmres gmres(options);
+    S21BiCgStab bicgstab(options);
+    Run("cg_jacobi", n, repetitions, [&] {
+      solution.Fill(0.0);
+      sink = cg.Solve(a, x, solution, &jacobi).residual;
+    });
+    Run("gmres_ilu0", n, repetitions, [&] {
+      solution.Fill(0.0);
+      sink = gmres.Solve(a, x, solution, &ilu).residual;
+    });
+    Run("bicgstab", n, repetitions, [&] {
+      solution.Fill(0.0);
+      sink = bicgstab.Solve(a, x, solution).residual;
+    });
+  }
+
+  for (int size : {64, 256}) {
+    S21Matrix a = Filled(size, 3);
+    S21Vector x(size, 1.0), y(size), u(size, 1e-3), v(size, 1e-3);
+    Run("gemv", size, repetitions, [&] {
+      y.Gemv(1.0, a, x, 0.0);
+      sink = y.data()[0];
+    });
+    Run("reduce_sum", size, repetitions, [&] { sink = S21Reduce::Sum(a); });
+    Run("col_sums", size, repetitions,
+        [&] { sink = S21Reduce::ColSums(a).Norm(); });
+    Run("map", size, repetitions, [&] {
+      sink = Map(a, [](double value) { return value * value; })(0, 0);
+    });
+
+    S21BandMatrix band(size, 1, 1);
+    for (int i = 0; i < size; i++) {
+      for (int j = std::max(0, i - 1); j <= std::min(size - 1, i + 1); j++) {
+        band(i, j) = a(i, j);
+      }
+    }
+    S21SymmetricMatrix symmetric(size);
+    symmetric.RankKUpdate(a, 1.0, 0.0);
+    S21TriangularMatrix lower(a, S21TriangularMatrix::kLower);
+    Run("band_mul", size, repetitions,
+        [&] { sink = band.MulMatrix(a)(0, 0); });
+    Run("symmetric_mul", size, repetitions,
+        [&] { sink = symmetric.MulMatrix(a)(0, 0); });
+    Run("triangular_solve", size, repetitions,
+        [&] { sink = lower.Solve(a)(0, 0); });
+
+    S21UpdatableInverse inverse(a);
+    S21LuFactorization lu(a);
+    S21CholeskyFactorization cholesky(a * a.Transpose());
+    Run("inverse_update", size, repetitions, [&] {
+      inverse.Update(u, v);
+      sink = inverse.determinant();
+    });
+    Run("lu_update", size, repetitions, [&] {
+      lu.Update(u, v);
+      sink = lu.Determinant();
+    });
+    Run("cholesky_update", size, repetitions, [&] {
+      cholesky.Update(u);
+      sink = cholesky.lower()(0, 0);
+    });
+  }
+
+  S21Matrix a = Filled(128, 4);
+  S21Matrix b = Filled(128, 5);
+  Run("distributed_mul", 128, repetitions,
+      [&] { sink = DistributedMulMatrix(a, b, 2, 2)(0, 0); });
+  (void)sink;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int repetitions = argc > 1 ? std::atoi(argv[1]) : 5;
+  if (repetitions <= 0) repetitions = 1;
+  const int sizes[] = {4, 16, 64, 128};
+
+  for (int size : sizes) {
+    S21Matrix a = Filled(size, 1);
+    S21Matrix b = Filled(size, 2);
+    volatile double sink = 0.0;
+
+    Run("sum", size, repetitions, [&] { sink = (a + b)(0, 0); });
+    Run("mul_number", size, repetitions, [&] { sink = (a * 2.0)(0, 0); });
+    Run("mul_matrix", size, repetitions, [&] { sink = (a * b)(0, 0); });
+    Run("transpose", size, repetitions, [&] {
+      S21Matrix copy(a);
+      sink = copy.Transpose()(0, 0);
+    });
+    Run("determinant", size, repetitions, [&] {
+      S21Matrix copy(a);
+      sink = copy.Determinant();
+    });
+    Run("inverse", size, repetitions, [&] {
+      S21Matrix copy(a);
+      sink = copy.InverseMatrix()(0, 0);
+    });
+    (void)sink;
+  }
+  RunKernels(repetitions);
+  return 0;
+}
@@ -1,4 +1,55 @@
 #include "s21_matrix_oop.h"
+
+#include "s21_executor.h"
+#include "s21_lu.h"
+#include "s21_matrix_stats.h"
+#include "s21_reduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// splitmix64 finalizer
+uint64_t Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t ElementHash(uint64_t index, double value) {
+  if (value == 0.0) value = 0.0;  // -0.0 == 0.0, so they must hash equal
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return Mix(bits ^ Mix(index));
+}
+
+// A Try* call that passed the argument checks failed because memory ran out
+// or the running task was cancelled
+[[noreturn]] void ThrowFailure() {
+  S21CancelToken::ThrowIfCancelled();
+  S21_THROW(std::bad_alloc());
+}
+
+}  // namespace
+
+struct S21Matrix::Derived {
+  double determinant = 0.0;
+  double norm = 0.0;
+  size_t hash = 0;
+  // Partial pivoting LU: row i of lu holds row permutation[i] of the source
+  S21Matrix lu;
+  std::unique_ptr<int[]> permutation;
+  int sign = 1;
+  S21LuStatus status = kS21LuRegular;
+};
+
 S21Matrix::S21Matrix() {
   rows_ = 0;
   cols_ = 0;
@@ -8,67 +59,111 @@ S21Matrix::S21Matrix() {
 // Constructor with parameters
 S21Matrix::S21Matrix(int rows, int cols) {
   if (rows <= 0 || cols <= 0) {
-    throw std::runtime_error(
-        "Error: The number of rows and columns must be greater than zero");
-  }
-  rows_ = rows;
-  cols_ = cols;
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
+    S21_THROW(std::runtime_error(
+        "Error: The number of rows and columns must be greater than zero"));
   }
+  S21_STATS_COUNT(kConstruct);
+  S21_STATS_ALLOC(kConstruct, rows * (sizeof(double*) + cols * sizeof(double)));
+  Allocate(rows, cols);
 }
 
 // Copy constructor
 S21Matrix::S21Matrix(const S21Matrix& other) {
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+  S21_STATS_COUNT(kCopy);
+  S21_STATS_ALLOC(kCopy, other.rows_ * (sizeof(double*) +
+                                        other.cols_ * sizeof(double)));
+  S21_STATS_COPY(kCopy, other.rows_ * other.cols_ * sizeof(double));
+  Allocate(other.rows_, other.cols_);
+  if (matrix_) {
+    std::memcpy(matrix_[0], other.matrix_[0],
+                sizeof(double) * rows_ * cols_);
   }
 }
 
 // Move constructor
-S21Matrix::S21Matrix(S21Matrix&& other) {
+S21Matrix::S21Matrix(S21Matrix&& other) noexcept {
+  S21_STATS_COUNT(kMove);
   rows_ = other.rows_;
   cols_ = other.cols_;
   matrix_ = other.matrix_;
+  valid_.store(other.valid_.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+  derived_ = std::move(other.derived_);
+  other.Invalidate();
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = NULL;
 }
 
 // Destructor
-S21Matrix::~S21Matrix() {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+S21Matrix::~S21Matrix() { Release(); }
+
+// All elements live in one block behind the row pointers, so whole-matrix
+// loops run over contiguous memory and a matrix costs two allocations
+void S21Matrix::Allocate(int rows, int cols) {
+  rows_ = rows;
+  cols_ = cols;
+  matrix_ = NULL;
+  if (rows > 0 && cols > 0 && !TryAllocate(rows, cols)) {
+    S21_THROW(std::bad_alloc());
+  }
+}
+
+// Expects rows, cols > 0 and no storage; leaves *this untouched on failure
+bool S21Matrix::TryAllocate(int rows, int cols) noexcept {
+  double** pointers = new (std::nothrow) double*[rows];
+  double* block =
+      pointers ? new (std::nothrow) double[size_t(rows) * cols] : NULL;
+  if (!block) {
+    delete[] pointers;
+    return false;
   }
-  delete[] matrix_;
+  rows_ = rows;
+  cols_ = cols;
+  matrix_ = pointers;
+  for (int i = 0; i < rows; i++) {
+    matrix_[i] = block + size_t(i) * cols;
+  }
+  return true;
+}
+
+void S21Matrix::Release() {
+  if (matrix_) {
+    delete[] matrix_[0];
+    delete[] matrix_;
+    matrix_ = NULL;
+  }
+}
+
+void S21Matrix::Swap(S21Matrix& other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(matrix_, other.matrix_);
+  Invalidate();
+  other.Invalidate();
 }
 
 // Setter functions
 void S21Matrix::set_rows(int rows) {
   if (rows <= 0) {
-    throw std::invalid_argument(
-        "Error: The number of rows must be greater than zero");
+    S21_THROW(std::invalid_argument(
+        "Error: The number of rows must be greater than zero"));
   }
   rows_ = rows;
+  Invalidate();
 }
 
 void S21Matrix::set_cols(int cols) {
   if (cols <= 0) {
-    throw std::invalid_argument(
-        "Error: The number of columns must be greater than zero");
+    S21_THROW(std::invalid_argument(
+        "Error: The number of columns must be greater than zero"));
   }
   cols_ = cols;
+  Invalidate();
 }
 
 // Member functions
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+bool S21Matrix::EqMatrix(const S21Matrix& other) const {
   bool result = true;
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     result = false;
@@ -84,34 +179,49 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) {
 }
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
-  int flag = OK;
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    flag = ERROR;
-    throw std::runtime_error(
-        "Error: The matrices must have the same dimensions");
+  if (TrySumMatrix(other) != OK) {
+    S21_THROW(std::runtime_error(
+        "Error: The matrices must have the same dimensions"));
   }
-  for (int i = 0; flag == OK && i < rows_; i++) {
+}
+
+int S21Matrix::TrySumMatrix(const S21Matrix& other) noexcept {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return ERROR;
+  S21_STATS_SCOPE(kSum);
+  S21_STATS_FLOPS(kSum, rows_ * cols_);
+  Invalidate();
+  for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] += other.matrix_[i][j];
     }
   }
+  return OK;
 }
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
-  int flag = OK;
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    flag = ERROR;
-    throw std::runtime_error(
-        "Error: The matrices must have the same dimensions");
+  if (TrySubMatrix(other) != OK) {
+    S21_THROW(std::runtime_error(
+        "Error: The matrices must have the same dimensions"));
   }
-  for (int i = 0; flag == OK && i < rows_; i++) {
+}
+
+int S21Matrix::TrySubMatrix(const S21Matrix& other) noexcept {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return ERROR;
+  S21_STATS_SCOPE(kSub);
+  S21_STATS_FLOPS(kSub, rows_ * cols_);
+  Invalidate();
+  for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] -= other.matrix_[i][j];
     }
   }
+  return OK;
 }
 
 void S21Matrix::MulNumber(const double num) {
+  S21_STATS_SCOPE(kMulNumber);
+  S21_STATS_FLOPS(kMulNumber, rows_ * cols_);
+  Invalidate();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] *= num;
@@ -120,16 +230,47 @@ void S21Matrix::MulNumber(const double num) {
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
-  int flag = OK;
+  S21Matrix result;
+  Multiply(other, result);
+  Swap(result);
+}
+
+int S21Matrix::TryMulMatrix(const S21Matrix& other) noexcept {
+  S21Matrix result;
+  if (TryMultiply(other, result) != OK) return ERROR;
+  Swap(result);
+  return OK;
+}
+
+void S21Matrix::Multiply(const S21Matrix& other, S21Matrix& result) const {
   if (this->cols_ != other.rows_) {
-    flag = ERROR;
-    throw std::runtime_error(
+    S21_THROW(std::runtime_error(
         "Number of columns in the first matrix should match number of rows in "
-        "the second matrix.");
+        "the second matrix."));
   }
-  S21Matrix result(rows_, other.cols_);
+  if (rows_ == 0 || other.cols_ == 0) {
+    S21_THROW(std::runtime_error(
+        "Error: The number of rows and columns must be greater than zero"));
+  }
+  if (TryMultiply(other, result) != OK) ThrowFailure();
+}
+
+// The product goes straight into new storage, so neither operand is copied
+int S21Matrix::TryMultiply(const S21Matrix& other,
+                           S21Matrix& result) const noexcept {
+  if (cols_ != other.rows_ || rows_ == 0 || other.cols_ == 0) return ERROR;
+  S21_STATS_SCOPE(kMulMatrix);
+  S21_STATS_FLOPS(kMulMatrix, 2ULL * rows_ * other.cols_ * cols_);
+  S21_STATS_ALLOC(kMulMatrix, rows_ * (sizeof(double*) +
+                                       other.cols_ * sizeof(double)));
+  if (!result.TryAllocate(rows_, other.cols_)) return ERROR;
 
   for (int i = 0; i < rows_; i++) {
+    if (S21CancelToken::CancellationRequested()) {
+      result.Release();
+      result.rows_ = result.cols_ = 0;
+      return ERROR;
+    }
     for (int j = 0; j < other.cols_; j++) {
       result.matrix_[i][j] = 0.0;
       for (int k = 0; k < cols_; k++) {
@@ -137,11 +278,11 @@ void S21Matrix::MulMatrix(const S21Matrix& other) {
       }
     }
   }
-
-  *this = S21Matrix(result);
+  return OK;
 }
 
-S21Matrix S21Matrix::Transpose() {
+S21Matrix S21Matrix::Transpose() const {
+  S21_STATS_SCOPE(kTranspose);
   S21Matrix result(cols_, rows_);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
@@ -155,8 +296,9 @@ S21Matrix S21Matrix::Minor(int row, int col) {
   int flag = OK;
   S21Matrix result;
   if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
-    throw std::runtime_error("S21Matrix::Minor: Invalid matrix index");
+    S21_THROW(std::runtime_error("S21Matrix::Minor: Invalid matrix index"));
   } else {
+    S21_STATS_SCOPE(kMinor);
     S21Matrix result(rows_ - 1, cols_ - 1);
     // for (int j = 1; j < rows_; j++) {
     //   for (int k = 0; k < cols_; k++) {
@@ -196,33 +338,109 @@ S21Matrix S21Matrix::Minor(int row, int col) {
 //   std::cout<< "\n";
 // }
 
-double S21Matrix::Determinant() {
-  int flag = OK;
+double S21Matrix::Determinant() const {
   if (rows_ != cols_) {
-    flag = ERROR;
-    throw std::runtime_error("Error: The matrix must be square");
+    S21_THROW(std::runtime_error("Error: The matrix must be square"));
   }
   double result = 0.0;
-  if (flag == OK && rows_ == 1) {
-    result = matrix_[0][0];
-  } else if (flag == OK && (rows_ == 2 || cols_ == 2)) {
-    result = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+  if (TryDeterminant(result) != OK) ThrowFailure();
+  return result;
+}
+
+int S21Matrix::TryDeterminant(double& result) const noexcept {
+  if (rows_ != cols_) return ERROR;
+  if (Valid(kDeterminant)) {
+    result = derived_->determinant;
+    return OK;
+  }
+  std::lock_guard<std::mutex> lock(derived_mutex_);
+  if (Valid(kDeterminant)) {  // Filled by another thread meanwhile
+    result = derived_->determinant;
+    return OK;
+  }
+  S21_STATS_SCOPE(kDeterminant);
+  double value = 0.0;
+  if (rows_ == 1) {
+    value = matrix_[0][0];
+  } else if (rows_ == 2) {
+    value = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
   } else {
-    // sprint();
-    for (int i = 0; flag == OK && i < cols_; i++) {
-      S21Matrix minor = Minor(0, i);
-      int ed = (i % 2 == 0) ? 1 : -1;
-      result += ed * matrix_[0][i] * minor.Determinant();
-      // minor.sprint();
+    if (TryFactorize() != OK) return ERROR;
+    const Derived& lu = *derived_;
+    if (lu.status != kS21LuSingular) {
+      value = lu.sign;
+      for (int i = 0; i < rows_; i++) value *= lu.lu.matrix_[i][i];
     }
   }
-  return result;
+  if (Derived* d = TryDerived()) {  // Not cached if out of memory
+    d->determinant = value;
+    valid_.fetch_or(kDeterminant, std::memory_order_release);
+  }
+  result = value;
+  return OK;
+}
+
+// Gaussian elimination with partial pivoting, O(n^3) instead of the O(n!)
+// cofactor expansion. Reuses the storage of the previous factorization.
+int S21Matrix::TryFactorize() const noexcept {
+  if (Valid(kFactorization)) return OK;
+  S21_STATS_SCOPE(kFactorize);
+  S21_STATS_FLOPS(kFactorize, 2ULL * rows_ * rows_ * rows_ / 3);
+  Derived* derived = TryDerived();
+  if (!derived) return ERROR;
+  Derived& d = *derived;
+  if (rows_ > 0 && (d.lu.rows_ != rows_ || d.lu.cols_ != cols_)) {
+    d.lu.Release();
+    d.permutation.reset(new (std::nothrow) int[rows_]);
+    if (!d.permutation || !d.lu.TryAllocate(rows_, cols_)) {
+      d.lu.rows_ = d.lu.cols_ = 0;
+      return ERROR;
+    }
+  }
+  double* a = NULL;
+  if (matrix_) {
+    a = d.lu.matrix_[0];
+    std::memcpy(a, matrix_[0], sizeof(double) * rows_ * cols_);
+  }
+  d.status = S21LuFactorize(a, rows_, d.permutation.get(), &d.sign,
+                            S21CancelToken::CancellationRequested);
+  if (d.status == kS21LuCancelled) return ERROR;
+  valid_.fetch_or(kFactorization, std::memory_order_release);
+  return OK;
+}
+
+double S21Matrix::Norm() const {
+  if (!Valid(kNorm)) {
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    if (!Valid(kNorm)) {
+      double sum = 0.0;
+      if (matrix_) {
+        sum = S21PairwiseSum(matrix_[0], size_t(rows_) * cols_,
+                             [](double value) { return value * value; });
+      }
+      derived().norm = std::sqrt(sum);
+      valid_.fetch_or(kNorm, std::memory_order_release);
+    }
+  }
+  return derived_->norm;
+}
+
+S21Matrix::Derived& S21Matrix::derived() const {
+  Derived* d = TryDerived();
+  if (!d) S21_THROW(std::bad_alloc());
+  return *d;
+}
+
+S21Matrix::Derived* S21Matrix::TryDerived() const noexcept {
+  if (!derived_) derived_.reset(new (std::nothrow) Derived);
+  return derived_.get();
 }
 
 S21Matrix S21Matrix::CalcComplements() {
+  S21_STATS_SCOPE(kComplements);
   S21Matrix result(rows_, cols_);
   if (rows_ != cols_) {
-    throw std::runtime_error("Error: The matrix must be square");
+    S21_THROW(std::runtime_error("Error: The matrix must be square"));
   } else if (rows_ == 2) {
     result.matrix_[0][0] = matrix_[1][1];
     result.matrix_[0][1] = -matrix_[1][0];
@@ -230,6 +448,7 @@ S21Matrix S21Matrix::CalcComplements() {
     result.matrix_[1][1] = matrix_[0][0];
   } else {
     for (int i = 0; i < rows_; i++) {
+      S21CancelToken::ThrowIfCancelled();
       for (int j = 0; j < cols_; j++) {
         S21Matrix sub_matrix(Minor(i, j));
         result.matrix_[i][j] = sub_matrix.Determinant();
@@ -245,90 +464,188 @@ S21Matrix S21Matrix::CalcComplements() {
 }
 
 S21Matrix S21Matrix::InverseMatrix() {
-  int flag = OK;
-  S21Matrix result(rows_, cols_);
-  double det = Determinant();
-  if (rows_ != cols_) {
-    flag = ERROR;
-    throw std::runtime_error("Error: The matrix must be square");
-  } else if (det == 0) {
-    flag = ERROR;
-    throw std::runtime_error("Error: The matrix is not invertible");
-
-  } else if (rows_ == 1) {
-    result.matrix_[0][0] = 1.0 / matrix_[0][0];
-  } else {
-    result = CalcComplements();
-    // result.sprint();
-    result = result.Transpose();
-    // result.sprint();
-    result.MulNumber(1.0 / det);
-    // result.sprint();
-    return result;
+  if (rows_ != cols_ || rows_ == 0) {
+    S21_THROW(std::runtime_error("Error: The matrix must be square"));
+  }
+  S21Matrix result;
+  if (TryInverseMatrix(result) != OK) {
+    if (Valid(kFactorization) && derived_->status != kS21LuRegular) {
+      S21_THROW(std::runtime_error("Error: The matrix is not invertible"));
+    }
+    ThrowFailure();
   }
-  if (flag = ERROR) result = S21Matrix();
   return result;
 }
 
+// Column j of the inverse solves L * U * x = P * e_j
+int S21Matrix::TryInverseMatrix(S21Matrix& result) const noexcept {
+  if (rows_ != cols_ || rows_ == 0) return ERROR;
+  S21_STATS_SCOPE(kInverse);
+  if (!Valid(kFactorization)) {
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    if (TryFactorize() != OK) return ERROR;
+  }
+  // Only the inverse refuses an ill-conditioned factorization: its entries
+  // would be rounding noise, while the determinant is still meaningful
+  if (derived_->status != kS21LuRegular) return ERROR;
+  S21Matrix inverse;
+  if (!inverse.TryAllocate(rows_, cols_)) return ERROR;
+  const Derived& d = *derived_;
+  double** lu = d.lu.matrix_;
+  double** x = inverse.matrix_;
+  for (int j = 0; j < cols_; j++) {
+    if (S21CancelToken::CancellationRequested()) return ERROR;
+    for (int i = 0; i < rows_; i++) {
+      double sum = d.permutation[i] == j ? 1.0 : 0.0;
+      for (int k = 0; k < i; k++) sum -= lu[i][k] * x[k][j];
+      x[i][j] = sum;
+    }
+    for (int i = rows_ - 1; i >= 0; i--) {
+      double sum = x[i][j];
+      for (int k = i + 1; k < cols_; k++) sum -= lu[i][k] * x[k][j];
+      x[i][j] = sum / lu[i][i];
+    }
+  }
+  result.Swap(inverse);
+  return OK;
+}
+
+size_t S21Matrix::Hash() const {
+  if (!Valid(kHash)) {
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    if (!Valid(kHash)) {
+      uint64_t result = Mix((uint64_t(rows_) << 32) ^ uint64_t(cols_));
+      for (int i = 0; i < rows_; i++) {
+        uint64_t row_sum = 0;
+        uint64_t base = uint64_t(i) * cols_;
+        for (int j = 0; j < cols_; j++) {
+          row_sum += ElementHash(base + j, matrix_[i][j]);
+        }
+        result += row_sum;
+      }
+      derived().hash = size_t(result);
+      valid_.fetch_or(kHash, std::memory_order_release);
+    }
+  }
+  return derived_->hash;
+}
+
+size_t S21Matrix::UpdateHash(size_t hash, int row, int col, double old_value,
+                             double new_value) const {
+  uint64_t index = uint64_t(row) * cols_ + col;
+  return size_t(uint64_t(hash) - ElementHash(index, old_value) +
+                ElementHash(index, new_value));
+}
+
+int S21Matrix::TryGet(int row, int col, double& value) const noexcept {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) return ERROR;
+  value = matrix_[row][col];
+  return OK;
+}
+
+int S21Matrix::TrySet(int row, int col, double value) noexcept {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) return ERROR;
+  bool hashed = Valid(kHash);
+  Invalidate();
+  if (hashed) {
+    derived_->hash =
+        UpdateHash(derived_->hash, row, col, matrix_[row][col], value);
+    valid_.store(kHash, std::memory_order_relaxed);
+  }
+  matrix_[row][col] = value;
+  return OK;
+}
+
 // Indexation by matrix elements (row, column)
 double& S21Matrix::operator()(int row, int col) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
-    throw std::runtime_error("Error: Index is outside the matrix");
+    S21_THROW(std::runtime_error("Error: Index is outside the matrix"));
   }
+  Invalidate();
   return matrix_[row][col];
 }
 
 const double& S21Matrix::operator()(int row, int col) const {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
-    throw std::runtime_error("Error: Index is outside the matrix");
+    S21_THROW(std::runtime_error("Error: Index is outside the matrix"));
   }
   return matrix_[row][col];
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
+S21Matrix S21Matrix::operator+(const S21Matrix& other) const& {
   S21Matrix result(*this);
   result.SumMatrix(other);
   return result;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
+S21Matrix S21Matrix::operator+(const S21Matrix& other) && {
+  SumMatrix(other);
+  return std::move(*this);
+}
+
+S21Matrix S21Matrix::operator-(const S21Matrix& other) const& {
   S21Matrix result(*this);
   result.SubMatrix(other);
   return result;
 }
 
+S21Matrix S21Matrix::operator-(const S21Matrix& other) && {
+  SubMatrix(other);
+  return std::move(*this);
+}
+
 S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+  S21Matrix result;
+  Multiply(other, result);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(double num) const {
+S21Matrix S21Matrix::operator*(double num) const& {
   S21Matrix result(*this);
   result.MulNumber(num);
   return result;
 }
 
+S21Matrix S21Matrix::operator*(double num) && {
+  MulNumber(num);
+  return std::move(*this);
+}
+
 bool S21Matrix::operator==(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  return result.EqMatrix(other);
+  return EqMatrix(other);
 }
 
 S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+  S21_STATS_COUNT(kAssign);
   if (this != &other) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
+    S21_STATS_ALLOC(kAssign, other.rows_ * (sizeof(double*) +
+                                            other.cols_ * sizeof(double)));
+    S21_STATS_COPY(kAssign, other.rows_ * other.cols_ * sizeof(double));
+    Invalidate();
+    Release();
+    Allocate(other.rows_, other.cols_);
+    if (matrix_) {
+      std::memcpy(matrix_[0], other.matrix_[0],
+                  sizeof(double) * rows_ * cols_);
     }
-    delete[] matrix_;
+  }
+  return *this;
+}
+
+S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
+  S21_STATS_COUNT(kMove);
+  if (this != &other) {
+    Release();
     rows_ = other.rows_;
     cols_ = other.cols_;
-    matrix_ = new double*[rows_];
-    for (int i = 0; i < rows_; i++) {
-      matrix_[i] = new double[cols_];
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
+    matrix_ = other.matrix_;
+    valid_.store(other.valid_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    derived_ = std::move(other.derived_);
+    other.Invalidate();
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.matrix_ = NULL;
   }
   return *this;
 }
@@ -351,4 +668,69 @@ S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
 S21Matrix& S21Matrix::operator*=(double num) {
   MulNumber(num);
   return *this;
-}
\ No newline at end of file
+}
+
+S21MatrixCache::S21MatrixCache(size_t capacity)
+    : capacity_(capacity), hits_(0), misses_(0) {}
+
+void S21MatrixCache::Clear() {
+  entries_.clear();
+  index_.clear();
+}
+
+S21MatrixCache::Entry& S21MatrixCache::Lookup(const S21Matrix& matrix) {
+  size_t hash = matrix.Hash();
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->source.EqMatrix(matrix)) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return entries_.front();
+    }
+  }
+  if (entries_.size() >= capacity_) {
+    Entry& last = entries_.back();
+    auto last_range = index_.equal_range(last.hash);
+    for (auto it = last_range.first; it != last_range.second; ++it) {
+      if (&*it->second == &last) {
+        index_.erase(it);
+        break;
+      }
+    }
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{hash, matrix, false, 0.0, false, S21Matrix()});
+  index_.emplace(hash, entries_.begin());
+  return entries_.front();
+}
+
+double S21MatrixCache::Determinant(const S21Matrix& matrix) {
+  if (capacity_ == 0) {
+    misses_++;
+    return S21Matrix(matrix).Determinant();
+  }
+  Entry& entry = Lookup(matrix);
+  if (entry.has_determinant) {
+    hits_++;
+  } else {
+    misses_++;
+    entry.determinant = entry.source.Determinant();
+    entry.has_determinant = true;
+  }
+  return entry.determinant;
+}
+
+S21Matrix S21MatrixCache::InverseMatrix(const S21Matrix& matrix) {
+  if (capacity_ == 0) {
+    misses_++;
+    return S21Matrix(matrix).InverseMatrix();
+  }
+  Entry& entry = Lookup(matrix);
+  if (entry.has_inverse) {
+    hits_++;
+  } else {
+    misses_++;
+    entry.inverse = entry.source.InverseMatrix();
+    entry.has_inverse = true;
+  }
+  return entry.inverse;
+}
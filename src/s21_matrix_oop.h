@@ -1,4 +1,16 @@
+#ifndef S21_MATRIX_OOP_H_
+#define S21_MATRIX_OOP_H_
+
+#include <atomic>
+#include <cstddef>
 #include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_error.h"
+
 #define OK 0
 #define ERROR 1
 
@@ -9,18 +21,60 @@ class S21Matrix {
   int rows_, cols_;  // Rows and columns
   double** matrix_;  // Pointer to the memory where the matrix is allocated
 
+  // Derived results are computed on first use and kept until the next write.
+  // Every mutator calls Invalidate(); valid_ holds one bit per result. Const
+  // queries may run on several threads at once: the first one fills the
+  // result under derived_mutex_ and publishes its bit with release order.
+  enum : unsigned {
+    kDeterminant = 1,
+    kFactorization = 2,
+    kNorm = 4,
+    kHash = 8
+  };
+  struct Derived;
+  mutable std::atomic<unsigned> valid_{0};
+  mutable std::mutex derived_mutex_;
+  mutable std::unique_ptr<Derived> derived_;
+
+  void Allocate(int rows, int cols);
+  bool TryAllocate(int rows, int cols) noexcept;  // new(std::nothrow)
+  void Release();
+  void Swap(S21Matrix& other) noexcept;  // Storage only; drops derived results
+  void Invalidate() { valid_.store(0, std::memory_order_relaxed); }
+  bool Valid(unsigned result) const {
+    return valid_.load(std::memory_order_acquire) & result;
+  }
+  Derived& derived() const;
+  Derived* TryDerived() const noexcept;
+  int TryFactorize() const noexcept;  // Caller holds derived_mutex_
+  // this * other into result, which must be empty
+  void Multiply(const S21Matrix& other, S21Matrix& result) const;
+  int TryMultiply(const S21Matrix& other, S21Matrix& result) const noexcept;
+
  public:
-  S21Matrix();                        // Default constructor
-  S21Matrix(int rows, int cols);      // Constructor with parameters
-  S21Matrix(const S21Matrix& other);  // Copy constructor
-  S21Matrix(S21Matrix&& other);       // Move constructor
-  ~S21Matrix();                       // Destructor
+  S21Matrix();                            // Default constructor
+  S21Matrix(int rows, int cols);          // Constructor with parameters
+  S21Matrix(const S21Matrix& other);      // Copy constructor
+  S21Matrix(S21Matrix&& other) noexcept;  // Move constructor
+  ~S21Matrix();                           // Destructor
 
   // Getter functions
   int rows() const { return rows_; }
 
   int cols() const { return cols_; }
 
+  // Unchecked access to a row for kernels. Rows are stored back to back, so
+  // row(0) also addresses all rows() * cols() elements. mutable_row() drops
+  // the cached derived results when it is called, not when the pointer is
+  // written through: take it for the writes at hand and do not keep it
+  // across a derived query such as Determinant() or Norm(). Read through
+  // row(), which keeps them.
+  const double* row(int i) const { return matrix_[i]; }
+  double* mutable_row(int i) {
+    Invalidate();
+    return matrix_[i];
+  }
+
   // Setter functions
 
   void set_cols(int cols);
@@ -28,38 +82,73 @@ class S21Matrix {
 
   // Member functions
   // void sprint();
-  bool EqMatrix(const S21Matrix& other);
+  bool EqMatrix(const S21Matrix& other) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
+  S21Matrix Transpose() const;
   S21Matrix Minor(int row, int col);
   S21Matrix CalcComplements();
-  double Determinant();
+  double Determinant() const;
   S21Matrix InverseMatrix();
-
-  // Indexation by matrix elements (row, column)
+  double Norm() const;  // Frobenius norm
+
+  // Content hash of the dimensions and element values, kept with the other
+  // derived results. Every element adds an independent position-dependent
+  // term, so matrices that compare equal hash equal and UpdateHash() folds a
+  // single element write in; TrySet() does so for the kept hash, other
+  // writes drop it.
+  size_t Hash() const;
+  size_t UpdateHash(size_t hash, int row, int col, double old_value,
+                    double new_value) const;
+
+  // Status-code variants that never throw and allocate with new(std::nothrow),
+  // for hot paths and code built with -fno-exceptions. They return OK, or
+  // ERROR on a dimension or index mismatch, a singular matrix, a failed
+  // allocation or a cancelled task, and then leave every argument unchanged.
+  int TrySumMatrix(const S21Matrix& other) noexcept;
+  int TrySubMatrix(const S21Matrix& other) noexcept;
+  int TryMulMatrix(const S21Matrix& other) noexcept;
+  int TryDeterminant(double& result) const noexcept;
+  // Solves with the LU factorization, O(n^3)
+  int TryInverseMatrix(S21Matrix& result) const noexcept;
+  int TryGet(int row, int col, double& value) const noexcept;
+  int TrySet(int row, int col, double value) noexcept;
+
+  // Indexation by matrix elements (row, column). The non-const overload may
+  // be written through, so it drops the cached derived results when called;
+  // a reference kept across a derived query and written later leaves them
+  // stale, so take a fresh one after Determinant(), Norm() and the like.
+  // Read-heavy code on a non-const matrix keeps the cache by reading through
+  // the const overload (std::as_const(m)(i, j)) or TryGet().
   double& operator()(int row, int col);
   const double& operator()(int row, int col) const;
 
   // Addition of two matrices. Different matrix dimensions.
-  S21Matrix operator+(const S21Matrix& other) const;
+  // The && overloads work in the storage of a temporary left operand, so
+  // only the first lvalue on the left is copied: (a + b - c) * 2.0 allocates
+  // one matrix, a + b - c * 2.0 two (c * 2.0 copies c).
+  S21Matrix operator+(const S21Matrix& other) const&;
+  S21Matrix operator+(const S21Matrix& other) &&;
 
   // Subtraction of one matrix from another. Different matrix dimensions.
-  S21Matrix operator-(const S21Matrix& other) const;
+  S21Matrix operator-(const S21Matrix& other) const&;
+  S21Matrix operator-(const S21Matrix& other) &&;
 
   // Matrix multiplication and matrix multiplication by a number. The number of
   // columns of the first matrix does not equal the number of rows of the second
   // matrix.
   S21Matrix operator*(const S21Matrix& other) const;
-  S21Matrix operator*(double num) const;
+  S21Matrix operator*(double num) const&;
+  S21Matrix operator*(double num) &&;
 
   // Checks for matrices equality (EqMatrix).
   bool operator==(const S21Matrix& other) const;
 
   // Assignment of values from one matrix to another one.
   S21Matrix& operator=(const S21Matrix& other);
+  S21Matrix& operator=(S21Matrix&& other) noexcept;
 
   // Addition assignment (SumMatrix) different matrix dimensions.
   S21Matrix& operator+=(const S21Matrix& other);
@@ -72,3 +161,43 @@ class S21Matrix {
   S21Matrix& operator*=(const S21Matrix& other);
   S21Matrix& operator*=(double num);
 };
+
+// Bounded LRU memoization of Determinant() and InverseMatrix() results keyed
+// by S21Matrix::Hash(), which an unchanged argument answers from its own
+// derived results. Entries keep a copy of the source matrix, so a hash
+// collision never returns a wrong result, and the LU factorization is
+// memoized in that copy: the determinant and the inverse of one entry
+// factorize it once.
+class S21MatrixCache {
+ public:
+  explicit S21MatrixCache(size_t capacity);
+
+  double Determinant(const S21Matrix& matrix);
+  S21Matrix InverseMatrix(const S21Matrix& matrix);
+
+  void Clear();
+
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return entries_.size(); }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+ private:
+  struct Entry {
+    size_t hash;
+    S21Matrix source;
+    bool has_determinant;
+    double determinant;
+    bool has_inverse;
+    S21Matrix inverse;
+  };
+
+  Entry& Lookup(const S21Matrix& matrix);
+
+  size_t capacity_;
+  size_t hits_, misses_;
+  std::list<Entry> entries_;  // Most recently used first
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+};
+
+#endif  // S21_MATRIX_OOP_H_
@@ -0,0 +1,400 @@
+// Performance regression suite. Built apart from s21_matrix_test.cc, with
+// optimization on and no coverage instrumentation:
+//
+//   ./perf_test [baseline.csv]                     compare with the baseline
+//   S21_PERF_UPDATE=1 ./perf_test [baseline.csv]   rewrite the baseline
+//
+// The default baseline is S21_PERF_BASELINE, which the builds set to the
+// file in the source directory, so the binary runs from any directory.
+//
+// Three kinds of checks:
+// - Allocation counts, through a replaced global operator new. They are
+//   exact, so an extra copy shows up as a failure on any machine.
+// - Complexity: the growth exponent of CPU time over a size sweep.
+// - Speed against the baseline. Times are stored as multiples of a fixed
+//   reference kernel compiled into this file, so the baseline carries over
+//   between machines. A case fails when it is slower than its baseline by
+//   more than kSlack plus a multiple of the noise measured in this run.
+//
+// Timed cases are single-threaded and use the thread CPU clock, so
+// scheduling and frequency changes of other cores do not leak in.
+
+#include <gtest/gtest.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "s21_elementwise.h"
+#include "s21_matrix_oop.h"
+#include "s21_solvers.h"
+#include "s21_vector.h"
+
+namespace {
+
+// Global, so allocations made by the executor's workers count as well
+std::atomic<bool> counting{false};
+std::atomic<long long> allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  if (counting) allocations++;
+  void* result = std::malloc(size ? size : 1);
+  if (!result) throw std::bad_alloc();
+  return result;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  if (counting) allocations++;
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Allowed slowdown over the baseline before noise, as a fraction
+const double kSlack = 1.0;
+// Timed batches per measurement; the fastest one counts
+const int kReps = 7;
+
+#ifndef S21_PERF_BASELINE
+#define S21_PERF_BASELINE "s21_matrix_perf_baseline.csv"
+#endif
+
+std::string baseline_path = S21_PERF_BASELINE;
+bool update_baseline = false;
+std::map<std::string, double> baseline;
+std::map<std::string, double> measured;
+volatile double sink;
+
+bool LoadBaseline() {
+  std::ifstream in(baseline_path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    size_t comma = line.find(',');
+    if (comma == std::string::npos) continue;
+    baseline[line.substr(0, comma)] = std::atof(line.c_str() + comma + 1);
+  }
+  return true;
+}
+
+void SaveBaseline() {
+  std::ofstream out(baseline_path);
+  out << "# Generated by S21_PERF_UPDATE=1 s21_matrix_perf_test\n"
+      << "# alloc.<case>: operator new calls, exact\n"
+      << "# time.<case>: CPU time in units of the reference kernel\n";
+  for (const auto& entry : measured) {
+    char value[32];
+    std::snprintf(value, sizeof(value), "%.4g", entry.second);
+    out << entry.first << ',' << value << '\n';
+  }
+}
+
+template <class F>
+long long CountAllocations(F f) {
+  allocations = 0;
+  counting = true;
+  f();
+  counting = false;
+  return allocations;
+}
+
+double CpuSeconds() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return double(now.tv_sec) + 1e-9 * double(now.tv_nsec);
+}
+
+struct Timing {
+  double seconds;  // Fastest batch, per call
+  double noise;    // (median - fastest) / fastest
+};
+
+// Batches are grown until they last at least 2 ms of CPU time
+template <class F>
+Timing Measure(F f) {
+  int batch = 1;
+  for (;;) {
+    double start = CpuSeconds();
+    for (int i = 0; i < batch; i++) f();
+    if (CpuSeconds() - start >= 2e-3 || batch >= (1 << 20)) break;
+    batch *= 2;
+  }
+  std::vector<double> samples;
+  for (int rep = 0; rep < kReps; rep++) {
+    double start = CpuSeconds();
+    for (int i = 0; i < batch; i++) f();
+    samples.push_back((CpuSeconds() - start) / batch);
+  }
+  std::sort(samples.begin(), samples.end());
+  double fastest = std::max(samples[0], 1e-12);
+  return Timing{fastest, (samples[kReps / 2] - fastest) / fastest};
+}
+
+// Plain ijk product of two 96 x 96 arrays, the unit of time
+const Timing& Reference() {
+  static const Timing timing = [] {
+    const int n = 96;
+    std::vector<double> a(n * n), b(n * n), c(n * n);
+    for (int i = 0; i < n * n; i++) {
+      a[i] = (i % 13) - 6.0;
+      b[i] = (i % 7) - 3.0;
+    }
+    return Measure([&] {
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          double sum = 0.0;
+          for (int k = 0; k < n; k++) sum += a[i * n + k] * b[k * n + j];
+          c[i * n + j] = sum;
+        }
+      }
+      sink = c[n + 1];
+    });
+  }();
+  return timing;
+}
+
+// Diagonally dominant, so every size is comfortably invertible
+S21Matrix Fill(int rows, int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    double* row = result.mutable_row(i);
+    for (int j = 0; j < cols; j++) {
+      row[j] = ((i * 37 + j * 11) % 23) - 11.0 + (i == j ? 4.0 * rows : 0.0);
+    }
+  }
+  return result;
+}
+
+void CheckAllocations(const std::string& name, long long count) {
+  std::string key = "alloc." + name;
+  measured[key] = double(count);
+  if (update_baseline) return;
+  auto expected = baseline.find(key);
+  if (expected == baseline.end()) {
+    ADD_FAILURE() << key << " is missing from " << baseline_path;
+    return;
+  }
+  EXPECT_EQ(count, (long long)expected->second) << key;
+}
+
+void CheckSpeed(const std::string& name, const Timing& timing) {
+  std::string key = "time." + name;
+  double units = timing.seconds / Reference().seconds;
+  measured[key] = units;
+  if (update_baseline) return;
+  auto expected = baseline.find(key);
+  if (expected == baseline.end()) {
+    ADD_FAILURE() << key << " is missing from " << baseline_path;
+    return;
+  }
+  double noise = std::max(timing.noise, Reference().noise);
+  double limit = expected->second * (1.0 + kSlack + 4.0 * noise);
+  EXPECT_LE(units, limit) << key << ": baseline " << expected->second
+                          << ", noise " << noise;
+}
+
+// k in t(n) ~ n^k, the least-squares slope of log t over log n
+template <class Op>
+double Exponent(const std::vector<int>& sizes, Op op) {
+  double mean_x = 0.0, mean_y = 0.0;
+  std::vector<double> x, y;
+  for (int n : sizes) {
+    x.push_back(std::log(double(n)));
+    y.push_back(std::log(op(n).seconds));
+    mean_x += x.back() / sizes.size();
+    mean_y += y.back() / sizes.size();
+  }
+  double covariance = 0.0, variance = 0.0;
+  for (size_t i = 0; i < x.size(); i++) {
+    covariance += (x[i] - mean_x) * (y[i] - mean_y);
+    variance += (x[i] - mean_x) * (x[i] - mean_x);
+  }
+  return covariance / variance;
+}
+
+Timing TimeDeterminant(int n) {
+  S21Matrix a = Fill(n, n);
+  return Measure([&] {
+    a(0, 0) += 0.0;  // Drops the cached factorization
+    sink = a.Determinant();
+  });
+}
+
+Timing TimeInverse(int n) {
+  S21Matrix a = Fill(n, n);
+  return Measure([&] {
+    a(0, 0) += 0.0;
+    sink = a.InverseMatrix()(0, 0);
+  });
+}
+
+Timing TimeMulMatrix(int n) {
+  S21Matrix a = Fill(n, n), b = Fill(n, n);
+  return Measure([&] { sink = (a * b)(0, 0); });
+}
+
+Timing TimeSum(int n) {
+  S21Matrix a = Fill(n, n), b = Fill(n, n);
+  return Measure([&] { sink = (a + b)(0, 0); });
+}
+
+S21SparseMatrix Poisson(int n) {
+  std::vector<S21SparseMatrix::Entry> entries;
+  for (int i = 0; i < n; i++) {
+    entries.push_back({i, i, 2.0});
+    if (i > 0) entries.push_back({i, i - 1, -1.0});
+    if (i + 1 < n) entries.push_back({i, i + 1, -1.0});
+  }
+  return S21SparseMatrix(n, entries);
+}
+
+}  // namespace
+
+TEST(Perf, Allocations) {
+  const int n = 64;
+  S21Matrix a = Fill(n, n), b = Fill(n, n), c = Fill(n, n);
+
+  // One matrix is a pointer array and an element block
+  long long matrix = CountAllocations([&] { S21Matrix copy(a); });
+  EXPECT_EQ(matrix, 2);
+  CheckAllocations("copy", matrix);
+  // Products and sums allocate their result only, never an operand copy
+  long long product = CountAllocations([&] { S21Matrix r = a * b; });
+  EXPECT_EQ(product, matrix);
+  CheckAllocations("mul_operator", product);
+  CheckAllocations("mul_in_place", CountAllocations([&] {
+                     S21Matrix r(a);
+                     r.MulMatrix(b);
+                   }) - matrix);
+  CheckAllocations("sum_operator",
+                   CountAllocations([&] { S21Matrix r = a + b; }));
+  CheckAllocations("expression_chain", CountAllocations([&] {
+                     S21Matrix r = (a + b - c) * 2.0;
+                   }));
+  CheckAllocations("equality", CountAllocations([&] { sink = a == b; }));
+
+  S21Matrix m(a);
+  CheckAllocations("determinant_first",
+                   CountAllocations([&] { sink = m.Determinant(); }));
+  CheckAllocations("determinant_cached",
+                   CountAllocations([&] { sink = m.Determinant(); }));
+  CheckAllocations("determinant_after_write", CountAllocations([&] {
+                     m(0, 0) += 0.0;
+                     sink = m.Determinant();
+                   }));
+  CheckAllocations("inverse", CountAllocations([&] {
+                     m(0, 0) += 0.0;
+                     sink = m.InverseMatrix()(0, 0);
+                   }));
+
+  auto square = [](double x) { return x * x; };
+  CheckAllocations("map_lvalue",
+                   CountAllocations([&] { S21Matrix r = Map(a, square); }));
+  S21Matrix temporary(a);
+  CheckAllocations("map_rvalue", CountAllocations([&] {
+                     S21Matrix r = Map(std::move(temporary), square);
+                   }));
+
+  // A warm solver only allocates the residual history of its result
+  S21SparseMatrix poisson = Poisson(500);
+  S21Vector rhs(500, 1.0), x;
+  S21ConjugateGradient cg;
+  cg.Solve(poisson, rhs, x);
+  CheckAllocations("cg_warm_solve", CountAllocations([&] {
+                     x.Fill(0.0);
+                     sink = cg.Solve(poisson, rhs, x).residual;
+                   }));
+  // Above the threading threshold the kernels run on the executor, which
+  // must not allocate per call either
+  const int large = 100000;
+  S21SparseMatrix large_poisson = Poisson(large);
+  S21Vector large_rhs(large, 1.0), large_x;
+  S21ConjugateGradient bounded;
+  bounded.options().max_iterations = 20;
+  bounded.Solve(large_poisson, large_rhs, large_x);
+  CheckAllocations("cg_warm_solve_parallel", CountAllocations([&] {
+                     large_x.Fill(0.0);
+                     sink = bounded.Solve(large_poisson, large_rhs, large_x)
+                                .residual;
+                   }));
+}
+
+TEST(Perf, Complexity) {
+  double determinant = Exponent({64, 128, 256}, TimeDeterminant);
+  double inverse = Exponent({64, 128, 256}, TimeInverse);
+  double product = Exponent({32, 64, 128}, TimeMulMatrix);
+  double sum = Exponent({64, 128, 256}, TimeSum);
+  std::printf("growth exponents: determinant %.2f, inverse %.2f, "
+              "mul_matrix %.2f, sum %.2f\n",
+              determinant, inverse, product, sum);
+  // Cubic, with room for cache effects; cofactor expansion would be
+  // factorial and blow far past the upper bound
+  EXPECT_GT(determinant, 2.0);
+  EXPECT_LT(determinant, 4.0);
+  EXPECT_GT(inverse, 2.0);
+  EXPECT_LT(inverse, 4.0);
+  EXPECT_GT(product, 2.0);
+  EXPECT_LT(product, 4.0);
+  EXPECT_GT(sum, 1.4);
+  EXPECT_LT(sum, 2.6);
+}
+
+TEST(Perf, Baseline) {
+  CheckSpeed("determinant_128", TimeDeterminant(128));
+  CheckSpeed("inverse_128", TimeInverse(128));
+  CheckSpeed("mul_matrix_96", TimeMulMatrix(96));
+  CheckSpeed("sum_256", TimeSum(256));
+
+  S21Matrix a = Fill(128, 128);
+  CheckSpeed("map_128", Measure([&] {
+               sink = Map(a, [](double x) { return x > 0.0 ? x : 0.1 * x; })(
+                   0, 0);
+             }));
+
+  S21SparseMatrix poisson = Poisson(500);
+  S21Vector rhs(500, 1.0), x;
+  S21ConjugateGradient cg;
+  CheckSpeed("cg_poisson_500", Measure([&] {
+               x.Fill(0.0);
+               sink = cg.Solve(poisson, rhs, x).residual;
+             }));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) baseline_path = argv[1];
+  update_baseline = std::getenv("S21_PERF_UPDATE") != nullptr;
+  if (!update_baseline && !LoadBaseline()) {
+    std::fprintf(stderr,
+                 "Error: Baseline %s not found; pass its path or create it "
+                 "with S21_PERF_UPDATE=1\n",
+                 baseline_path.c_str());
+    return 1;
+  }
+  int result = RUN_ALL_TESTS();
+  if (update_baseline) SaveBaseline();
+  return result;
+}
@@ -0,0 +1,181 @@
+#ifndef S21_MATRIX_STATS_H_
+#define S21_MATRIX_STATS_H_
+
+// Operation instrumentation for S21Matrix. Build with -DS21_MATRIX_INSTRUMENT
+// to enable it; otherwise the S21_STATS_* macros expand to nothing and
+// Take() returns zeros.
+//
+// The library and every translation unit that includes it must be built with
+// the same setting.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class S21MatrixStats {
+ public:
+  enum Op {
+    kConstruct,
+    kCopy,
+    kMove,
+    kAssign,
+    kSum,
+    kSub,
+    kMulNumber,
+    kMulMatrix,
+    kTranspose,
+    kMinor,
+    kComplements,
+    kDeterminant,
+    kFactorize,
+    kInverse,
+    kOpCount
+  };
+
+  // Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds
+  static constexpr int kLatencyBuckets = 40;
+
+  struct OpStats {
+    uint64_t calls;
+    uint64_t flops;
+    uint64_t bytes_allocated;
+    uint64_t bytes_copied;
+    uint64_t latency_ns[kLatencyBuckets];
+  };
+
+  struct Snapshot {
+    OpStats ops[kOpCount];
+  };
+
+  // Called on entry (begin == true) and exit of every timed operation, e.g.
+  // to forward to __itt_task_begin/__itt_task_end or a perf marker.
+  using TraceHook = void (*)(Op op, const char* name, bool begin);
+
+  static const char* Name(Op op) {
+    static const char* const names[kOpCount] = {
+        "construct", "copy",        "move",        "assign",   "sum",
+        "sub",       "mul_number",  "mul_matrix",  "transpose", "minor",
+        "complements", "determinant", "factorize", "inverse"};
+    return names[op];
+  }
+
+#ifdef S21_MATRIX_INSTRUMENT
+  static Snapshot Take() {
+    Snapshot result;
+    for (int i = 0; i < kOpCount; i++) {
+      Counters& c = counters_[i];
+      OpStats& s = result.ops[i];
+      s.calls = c.calls.load(std::memory_order_relaxed);
+      s.flops = c.flops.load(std::memory_order_relaxed);
+      s.bytes_allocated = c.bytes_allocated.load(std::memory_order_relaxed);
+      s.bytes_copied = c.bytes_copied.load(std::memory_order_relaxed);
+      for (int b = 0; b < kLatencyBuckets; b++) {
+        s.latency_ns[b] = c.latency_ns[b].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+
+  static void Reset() {
+    for (Counters& c : counters_) {
+      c.calls = 0;
+      c.flops = 0;
+      c.bytes_allocated = 0;
+      c.bytes_copied = 0;
+      for (auto& bucket : c.latency_ns) bucket = 0;
+    }
+  }
+
+  static void SetTraceHook(TraceHook hook) { hook_ = hook; }
+
+  static void Count(Op op) {
+    counters_[op].calls.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Flops, allocations and copies are charged to the innermost timed
+  // operation, or to op when there is none.
+  static void AddFlops(Op op, uint64_t flops) {
+    counters_[Current(op)].flops.fetch_add(flops, std::memory_order_relaxed);
+  }
+  static void AddAllocated(Op op, uint64_t bytes) {
+    counters_[Current(op)].bytes_allocated.fetch_add(
+        bytes, std::memory_order_relaxed);
+  }
+  static void AddCopied(Op op, uint64_t bytes) {
+    counters_[Current(op)].bytes_copied.fetch_add(bytes,
+                                                  std::memory_order_relaxed);
+  }
+
+  class Scope {
+   public:
+    explicit Scope(Op op)
+        : op_(op), parent_(current_), start_(std::chrono::steady_clock::now()) {
+      current_ = op;
+      Count(op);
+      TraceHook hook = hook_.load(std::memory_order_relaxed);
+      if (hook) hook(op, Name(op), true);
+    }
+    ~Scope() {
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_)
+                        .count();
+      int bucket = 0;
+      while (bucket + 1 < kLatencyBuckets && (ns >> (bucket + 1)) != 0) {
+        bucket++;
+      }
+      counters_[op_].latency_ns[bucket].fetch_add(1,
+                                                  std::memory_order_relaxed);
+      TraceHook hook = hook_.load(std::memory_order_relaxed);
+      if (hook) hook(op_, Name(op_), false);
+      current_ = parent_;
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Op op_, parent_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+ private:
+  // Only used with static storage duration, so zero-initialized
+  struct Counters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> flops;
+    std::atomic<uint64_t> bytes_allocated;
+    std::atomic<uint64_t> bytes_copied;
+    std::atomic<uint64_t> latency_ns[kLatencyBuckets];
+  };
+
+  static Op Current(Op op) { return current_ == kOpCount ? op : current_; }
+
+  static inline Counters counters_[kOpCount];
+  static inline std::atomic<TraceHook> hook_{nullptr};
+  static inline thread_local Op current_ = kOpCount;
+#else
+  static Snapshot Take() { return Snapshot(); }
+  static void Reset() {}
+  static void SetTraceHook(TraceHook) {}
+#endif
+};
+
+#ifdef S21_MATRIX_INSTRUMENT
+#define S21_STATS_CONCAT_(a, b) a##b
+#define S21_STATS_NAME_(line) S21_STATS_CONCAT_(s21_stats_scope_, line)
+#define S21_STATS_SCOPE(op) \
+  S21MatrixStats::Scope S21_STATS_NAME_(__LINE__)(S21MatrixStats::op)
+#define S21_STATS_COUNT(op) S21MatrixStats::Count(S21MatrixStats::op)
+#define S21_STATS_FLOPS(op, n) \
+  S21MatrixStats::AddFlops(S21MatrixStats::op, uint64_t(n))
+#define S21_STATS_ALLOC(op, bytes) \
+  S21MatrixStats::AddAllocated(S21MatrixStats::op, uint64_t(bytes))
+#define S21_STATS_COPY(op, bytes) \
+  S21MatrixStats::AddCopied(S21MatrixStats::op, uint64_t(bytes))
+#else
+#define S21_STATS_SCOPE(op) ((void)0)
+#define S21_STATS_COUNT(op) ((void)0)
+#define S21_STATS_FLOPS(op, n) ((void)0)
+#define S21_STATS_ALLOC(op, bytes) ((void)0)
+#define S21_STATS_COPY(op, bytes) ((void)0)
+#endif
+
+#endif  // S21_MATRIX_STATS_H_
@@ -1,6 +1,22 @@
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "s21_distributed.h"
+#include "s21_elementwise.h"
+#include "s21_matrix_async.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_stats.h"
+#include "s21_reduce.h"
+#include "s21_solvers.h"
+#include "s21_structured.h"
+#include "s21_update.h"
+#include "s21_vector.h"
 
 TEST(Constructor, DefaultConstructor) {
   S21Matrix matrix;
@@ -24,6 +40,9 @@ TEST(Constructor, CopyConstructor) {
 }
 
 TEST(Constructor, MoveConstructor) {
+  // Lets std::vector<S21Matrix> move instead of copy when it grows
+  static_assert(std::is_nothrow_move_constructible<S21Matrix>::value);
+  static_assert(std::is_nothrow_move_assignable<S21Matrix>::value);
   S21Matrix original(2, 3);
   original(0, 0) = 1.0;
   S21Matrix moved(std::move(original));
@@ -552,6 +571,979 @@ TEST(Operators, Exceptions) {
   EXPECT_FALSE(matrix1 == matrix2);
 }
 
+TEST(LinearAlgebra, DeterminantLarge) {
+  S21Matrix matrix(4, 4);
+  double values[4][4] = {
+      {2, -1, 0, 3}, {1, 4, -2, 0}, {0, 5, 1, -1}, {3, 0, 2, 2}};
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+  EXPECT_NEAR(matrix.Determinant(), -74.0, 1e-9);
+
+  matrix(3, 0) = 0;
+  matrix(3, 1) = 0;
+  matrix(3, 2) = 0;
+  matrix(3, 3) = 0;
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 0.0);
+}
+
+TEST(LinearAlgebra, DerivedResultsInvalidated) {
+  S21Matrix matrix(3, 3);
+  double values[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 8}};
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 3.0);
+  EXPECT_DOUBLE_EQ(matrix.Transpose()(0, 1), 4.0);
+  EXPECT_DOUBLE_EQ(matrix.Norm(), std::sqrt(268.0));
+
+  matrix(2, 2) = 9;
+  EXPECT_NEAR(matrix.Determinant(), 0.0, 1e-12);
+  EXPECT_DOUBLE_EQ(matrix.Norm(), std::sqrt(285.0));
+
+  matrix.MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(matrix.Transpose()(0, 1), 8.0);
+
+  S21Matrix identity(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      identity(i, j) = i == j;
+    }
+  }
+  EXPECT_DOUBLE_EQ(identity.Determinant(), 1.0);
+  identity.SumMatrix(identity);
+  EXPECT_DOUBLE_EQ(identity.Determinant(), 8.0);
+  identity = matrix;
+  EXPECT_DOUBLE_EQ(identity.Transpose()(0, 1), 8.0);
+}
+
+TEST(LinearAlgebra, ConstReadsKeepDerivedResults) {
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix(i, j) = 2.0 * (i == j);
+    }
+  }
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 8.0);
+  double& element = matrix(0, 0);  // Drops the cache when taken
+  element = 10.0;
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 40.0);
+  matrix(1, 1) *= 2.0;
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 80.0);
+
+  S21MatrixStats::Reset();
+  double sum = 0.0, value = 0.0;
+  for (int i = 0; i < 3; i++) sum += std::as_const(matrix)(i, i);
+  EXPECT_EQ(matrix.TryGet(2, 2, value), OK);
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 80.0);
+  EXPECT_DOUBLE_EQ(sum + value, 18.0);
+  // Neither read refactorized the matrix
+  EXPECT_EQ(S21MatrixStats::Take().ops[S21MatrixStats::kFactorize].calls, 0U);
+}
+
+TEST(LinearAlgebra, ConcurrentConstQueries) {
+  S21Matrix source(40, 40);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 40; j++) {
+      source(i, j) = (i * 7 + j * 3) % 11 - 5.0 + 50.0 * (i == j);
+    }
+  }
+  const double determinant = S21Matrix(source).Determinant();
+  const double norm = S21Matrix(source).Norm();
+  const S21Matrix& shared = source;
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      S21Matrix inverse;
+      for (int rep = 0; rep < 50; rep++) {
+        if (shared.Determinant() != determinant) mismatches[t]++;
+        if (shared.Norm() != norm) mismatches[t]++;
+        if (shared.TryInverseMatrix(inverse) != OK) mismatches[t]++;
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (int count : mismatches) EXPECT_EQ(count, 0);
+}
+
+TEST(LinearAlgebra, RoundingLevelPivotHasNoInverse) {
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix(i, j) = 3 * i + j + 1;
+    }
+  }
+  S21Matrix inverse;
+  EXPECT_NEAR(matrix.Determinant(), 0.0, 1e-12);
+  EXPECT_THROW(matrix.InverseMatrix(), std::runtime_error);
+  EXPECT_EQ(matrix.TryInverseMatrix(inverse), ERROR);
+  EXPECT_EQ(inverse.rows(), 0);
+
+  matrix *= 1e-100;  // The tolerance scales with the elements
+  EXPECT_THROW(matrix.InverseMatrix(), std::runtime_error);
+  matrix(2, 2) = 10e-100;
+  EXPECT_NEAR(matrix.Determinant() / 1e-300, -3.0, 1e-12);
+  S21Matrix product = matrix * matrix.InverseMatrix();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(product(i, j), i == j, 1e-12);
+    }
+  }
+}
+
+TEST(LinearAlgebra, BadlyScaledDiagonal) {
+  const double scales[][3] = {{1e16, 1, 1}, {1, 1, 1e-16}, {1e16, 1, 1e-16}};
+  for (const auto& scale : scales) {
+    S21DiagonalMatrix diagonal({scale[0], scale[1], scale[2]});
+    S21Matrix dense = diagonal.ToDense();
+    EXPECT_DOUBLE_EQ(dense.Determinant(), diagonal.Determinant());
+    S21Matrix inverse = dense.InverseMatrix();
+    for (int i = 0; i < 3; i++) {
+      EXPECT_DOUBLE_EQ(inverse(i, i), 1.0 / scale[i]);
+    }
+  }
+  // The 2 x 2 closed form and the LU path agree
+  S21Matrix small(2, 2);
+  small(0, 0) = 1.0;
+  small(0, 1) = small(1, 0) = 0.0;
+  small(1, 1) = 1e-17;
+  EXPECT_DOUBLE_EQ(small.Determinant(), 1e-17);
+  EXPECT_DOUBLE_EQ(small.InverseMatrix()(1, 1), 1e17);
+}
+
+TEST(Cache, Hash) {
+  S21Matrix matrix1(2, 2);
+  S21Matrix matrix2(2, 2);
+
+  matrix1(0, 0) = 1.0;
+  matrix1(0, 1) = 2.0;
+  matrix1(1, 0) = 3.0;
+  matrix1(1, 1) = 0.0;
+  matrix2 = matrix1;
+  matrix2(1, 1) = -0.0;
+
+  EXPECT_EQ(matrix1.Hash(), matrix2.Hash());
+  EXPECT_NE(matrix1.Hash(), matrix1.Transpose().Hash());
+
+  size_t hash = matrix1.Hash();
+  hash = matrix1.UpdateHash(hash, 0, 1, matrix1(0, 1), 5.0);
+  matrix1(0, 1) = 5.0;
+  EXPECT_EQ(hash, matrix1.Hash());
+
+  // TrySet folds the write into the kept hash
+  EXPECT_EQ(matrix1.TrySet(1, 0, -4.0), OK);
+  matrix2 = matrix1;
+  EXPECT_EQ(matrix1.Hash(), matrix2.Hash());
+  EXPECT_NE(matrix1.Hash(), hash);
+}
+
+TEST(Cache, FactorizesEachEntryOnce) {
+  S21MatrixCache cache(2);
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) matrix(i, j) = (i == j) ? 4.0 : 1.0;
+  }
+
+  S21MatrixStats::Reset();
+  EXPECT_DOUBLE_EQ(cache.Determinant(matrix), 54.0);
+  S21Matrix inverse = cache.InverseMatrix(matrix);
+  EXPECT_DOUBLE_EQ(inverse(0, 0), 15.0 / 54.0);
+  EXPECT_EQ(cache.misses(), 2U);
+#ifdef S21_MATRIX_INSTRUMENT
+  EXPECT_EQ(S21MatrixStats::Take().ops[S21MatrixStats::kFactorize].calls, 1U);
+#endif
+}
+
+TEST(Cache, HitsAndMisses) {
+  S21MatrixCache cache(2);
+  S21Matrix matrix(2, 2);
+
+  matrix(0, 0) = 1.0;
+  matrix(0, 1) = 2.0;
+  matrix(1, 0) = 3.0;
+  matrix(1, 1) = 4.0;
+
+  EXPECT_DOUBLE_EQ(cache.Determinant(matrix), -2.0);
+  EXPECT_DOUBLE_EQ(cache.Determinant(matrix), -2.0);
+  S21Matrix inverse = cache.InverseMatrix(matrix);
+  EXPECT_TRUE(inverse == cache.InverseMatrix(matrix));
+  EXPECT_DOUBLE_EQ(inverse(1, 0), 1.5);
+  EXPECT_EQ(cache.hits(), 2U);
+  EXPECT_EQ(cache.misses(), 2U);
+  EXPECT_EQ(cache.size(), 1U);
+
+  S21Matrix other(matrix);
+  other(1, 1) = 5.0;
+  S21Matrix third(matrix);
+  third(1, 1) = 6.0;
+  cache.Determinant(other);
+  cache.Determinant(third);
+  EXPECT_EQ(cache.size(), 2U);
+  cache.Determinant(matrix);
+  EXPECT_EQ(cache.misses(), 5U);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0U);
+}
+
+namespace {
+int trace_events = 0;
+void CountTrace(S21MatrixStats::Op, const char*, bool) { trace_events++; }
+}  // namespace
+
+TEST(Stats, Counters) {
+  S21Matrix matrix1(2, 3);
+  S21Matrix matrix2(3, 2);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix1(i, j) = i + j;
+      matrix2(j, i) = i - j;
+    }
+  }
+
+  S21MatrixStats::Reset();
+  S21MatrixStats::SetTraceHook(CountTrace);
+  trace_events = 0;
+  S21Matrix result = matrix1 * matrix2;
+  S21MatrixStats::SetTraceHook(nullptr);
+  S21MatrixStats::Snapshot stats = S21MatrixStats::Take();
+  const S21MatrixStats::OpStats& mul = stats.ops[S21MatrixStats::kMulMatrix];
+
+#ifdef S21_MATRIX_INSTRUMENT
+  EXPECT_EQ(mul.calls, 1U);
+  EXPECT_EQ(mul.flops, 24U);
+  EXPECT_GT(mul.bytes_allocated, 0U);
+  EXPECT_EQ(stats.ops[S21MatrixStats::kCopy].calls, 0U);  // No operand copy
+  uint64_t timed = 0;
+  for (uint64_t bucket : mul.latency_ns) timed += bucket;
+  EXPECT_EQ(timed, 1U);
+  EXPECT_EQ(trace_events, 2);
+#else
+  EXPECT_EQ(mul.calls, 0U);
+  EXPECT_EQ(mul.flops, 0U);
+  EXPECT_EQ(trace_events, 0);
+#endif
+  EXPECT_STREQ(S21MatrixStats::Name(S21MatrixStats::kMulMatrix), "mul_matrix");
+}
+
+TEST(Async, MulThenInverse) {
+  S21Matrix matrix1(2, 2);
+  S21Matrix matrix2(2, 2);
+
+  matrix1(0, 0) = 1.0;
+  matrix1(0, 1) = 2.0;
+  matrix1(1, 0) = 3.0;
+  matrix1(1, 1) = 4.0;
+  matrix2(0, 0) = 1.0;
+  matrix2(0, 1) = 0.0;
+  matrix2(1, 0) = 0.0;
+  matrix2(1, 1) = 1.0;
+
+  S21Executor executor(2);
+  S21CancelToken token;
+  S21Future<S21Matrix> product =
+      MulMatrixAsync(matrix1, matrix2, token, executor);
+  std::future<S21Matrix> inverse = Then(
+      std::move(product), [](S21Matrix m) { return m.InverseMatrix(); },
+      token, executor);
+  S21Matrix result = inverse.get();
+
+  EXPECT_DOUBLE_EQ(result(0, 0), -2.0);
+  EXPECT_DOUBLE_EQ(result(1, 0), 1.5);
+  EXPECT_DOUBLE_EQ(DeterminantAsync(matrix1, token, executor).get(), -2.0);
+
+  S21Matrix wrong(3, 3);
+  EXPECT_THROW(MulMatrixAsync(matrix1, wrong, token, executor).get(),
+               std::runtime_error);
+}
+
+TEST(Async, Cancel) {
+  S21Executor executor(1);
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  std::future<void> blocker = executor.Submit([opened] { opened.wait(); });
+
+  S21Matrix matrix(3, 3);
+  S21CancelToken token;
+  S21Future<S21Matrix> product =
+      MulMatrixAsync(matrix, matrix, token, executor);
+  std::future<S21Matrix> inverse = Then(
+      std::move(product), [](S21Matrix m) { return m.InverseMatrix(); },
+      token, executor);
+  token.Cancel();
+  gate.set_value();
+  blocker.get();
+
+  EXPECT_TRUE(token.cancelled());
+  EXPECT_THROW(inverse.get(), S21Cancelled);
+}
+
+TEST(Async, PendingThenHoldsNoWorker) {
+  S21Executor other(1);
+  S21Executor executor(1);
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  S21Future<int> first = other.Submit([opened] {
+    opened.wait();
+    return 1;
+  });
+  S21Future<int> second =
+      Then(std::move(first), [](int value) { return value + 1; },
+           S21CancelToken(), executor);
+  // Waiting in first.get() on executor's only worker would deadlock here
+  executor.Submit([&gate] { gate.set_value(); }).get();
+  EXPECT_EQ(second.get(), 2);
+
+  // Already finished predecessors are chained right away
+  S21Future<int> done = executor.Submit([] { return 3; });
+  done.wait();
+  EXPECT_EQ(Then(std::move(done), [](int value) { return value * 2; },
+                 S21CancelToken(), executor)
+                .get(),
+            6);
+}
+
+TEST(Async, ParallelFor) {
+  S21Executor executor(3);
+  std::vector<int> hits(1000, 0);
+  executor.ParallelFor(0, 1000, 10, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) hits[i]++;
+  });
+  for (int count : hits) EXPECT_EQ(count, 1);
+
+  // Callers on several threads share the workers
+  std::vector<std::atomic<int>> totals(4);
+  std::vector<std::thread> callers;
+  for (int t = 0; t < 4; t++) {
+    callers.emplace_back([&, t] {
+      for (int rep = 0; rep < 100; rep++) {
+        executor.ParallelFor(0, 64, 1, [&](int begin, int end) {
+          totals[t] += end - begin;
+        });
+      }
+    });
+  }
+  for (std::thread& caller : callers) caller.join();
+  for (std::atomic<int>& total : totals) EXPECT_EQ(total.load(), 6400);
+
+  EXPECT_THROW(executor.ParallelFor(0, 64, 1,
+                                    [](int begin, int) {
+                                      if (begin > 0) {
+                                        throw std::runtime_error("chunk");
+                                      }
+                                    }),
+               std::runtime_error);
+}
+
+namespace {
+S21Matrix Sample(int rows, int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      result(i, j) = (i * 7 + j * 3) % 5 - 1.5;
+    }
+  }
+  return result;
+}
+
+void ExpectNear(const S21Matrix& actual, const S21Matrix& expected) {
+  ASSERT_EQ(actual.rows(), expected.rows());
+  ASSERT_EQ(actual.cols(), expected.cols());
+  for (int i = 0; i < actual.rows(); i++) {
+    for (int j = 0; j < actual.cols(); j++) {
+      EXPECT_NEAR(actual(i, j), expected(i, j), 1e-9);
+    }
+  }
+}
+}  // namespace
+
+TEST(Structured, Diagonal) {
+  S21DiagonalMatrix diagonal({2.0, -1.0, 4.0});
+  S21Matrix other = Sample(3, 2);
+
+  EXPECT_DOUBLE_EQ(diagonal.Determinant(), -8.0);
+  EXPECT_DOUBLE_EQ(diagonal.InverseMatrix()(2, 2), 0.25);
+  EXPECT_DOUBLE_EQ(diagonal(0, 1), 0.0);
+  ExpectNear(diagonal.MulMatrix(other), diagonal.ToDense() * other);
+  diagonal(1) = 0.0;
+  EXPECT_THROW(diagonal.InverseMatrix(), std::runtime_error);
+}
+
+TEST(Structured, Triangular) {
+  S21Matrix dense = Sample(4, 4);
+  for (int i = 0; i < 4; i++) dense(i, i) = 3.0 + i;
+  S21Matrix rhs = Sample(4, 3);
+
+  for (auto uplo : {S21TriangularMatrix::kLower, S21TriangularMatrix::kUpper}) {
+    S21TriangularMatrix triangle(dense, uplo);
+    S21Matrix full = triangle.ToDense();
+
+    EXPECT_NEAR(triangle.Determinant(), full.Determinant(), 1e-9);
+    ExpectNear(triangle.MulMatrix(rhs), full * rhs);
+    ExpectNear(full * triangle.Solve(rhs), rhs);
+    ExpectNear(triangle.InverseMatrix().ToDense(), full.InverseMatrix());
+  }
+  S21TriangularMatrix lower(3, S21TriangularMatrix::kLower);
+  EXPECT_THROW(lower(0, 1) = 1.0, std::runtime_error);
+  EXPECT_THROW(lower.Solve(rhs), std::runtime_error);
+}
+
+TEST(Structured, SymmetricRankK) {
+  S21Matrix a = Sample(3, 2);
+  S21SymmetricMatrix symmetric(3);
+  symmetric(0, 1) = 1.0;
+  symmetric(2, 2) = 2.0;
+  EXPECT_DOUBLE_EQ(symmetric(1, 0), 1.0);
+
+  S21Matrix expected = a * a.Transpose() * 2.0 + symmetric.ToDense() * 0.5;
+  symmetric.RankKUpdate(a, 2.0, 0.5);
+  ExpectNear(symmetric.ToDense(), expected);
+
+  S21Matrix other = Sample(3, 4);
+  ExpectNear(symmetric.MulMatrix(other), symmetric.ToDense() * other);
+}
+
+TEST(Structured, Banded) {
+  S21BandMatrix band(5, 1, 2);
+  for (int i = 0; i < 5; i++) {
+    for (int j = std::max(0, i - 1); j <= std::min(4, i + 2); j++) {
+      band(i, j) = i - 2.0 * j + 1.0;
+    }
+  }
+  S21Matrix other = Sample(5, 3);
+  const S21BandMatrix& view = band;
+
+  EXPECT_DOUBLE_EQ(view(4, 0), 0.0);
+  EXPECT_THROW(band(3, 0) = 1.0, std::runtime_error);
+  EXPECT_THROW(S21BandMatrix(3, 3, 0), std::runtime_error);
+  ExpectNear(band.MulMatrix(other), band.ToDense() * other);
+}
+
+TEST(Distributed, Summa) {
+  S21Matrix a = Sample(7, 5);
+  S21Matrix b = Sample(5, 6);
+  S21Matrix expected = a * b;
+
+  ExpectNear(DistributedMulMatrix(a, b, 2, 2, 2), expected);
+  ExpectNear(DistributedMulMatrix(a, b, 1, 3, 3), expected);
+  ExpectNear(DistributedMulMatrix(a, b, 3, 1), expected);
+  EXPECT_THROW(DistributedMulMatrix(a, a, 2, 2), std::runtime_error);
+}
+
+TEST(Distributed, ProcessGroup) {
+  S21ProcessGroup group(4);
+  int sum = 0;
+  group.Run(
+      sizeof(int) * 4, [](char*) {},
+      [&group](int rank, char* shared) {
+        reinterpret_cast<int*>(shared)[rank] = rank + 1;
+        group.Barrier();
+        if (reinterpret_cast<int*>(shared)[3 - rank] != 4 - rank) {
+          throw std::runtime_error("Barrier did not synchronize");
+        }
+      },
+      [&sum](const char* shared) {
+        const int* values = reinterpret_cast<const int*>(shared);
+        for (int i = 0; i < 4; i++) sum += values[i];
+      });
+  EXPECT_EQ(sum, 10);
+
+  EXPECT_THROW(group.Run(
+                   0, [](char*) {},
+                   [&group](int rank, char*) {
+                     group.Barrier();
+                     if (rank == 2) throw std::runtime_error("worker failed");
+                   },
+                   [](const char*) {}),
+               std::runtime_error);
+  EXPECT_THROW(group.Run(
+                   0, [](char*) {},
+                   [&group](int rank, char*) {
+                     if (rank == 0) throw std::runtime_error("worker failed");
+                     group.Barrier();
+                   },
+                   [](const char*) {}),
+               std::runtime_error);
+}
+
+TEST(Vector, Kernels) {
+  S21Vector x = {1.0, 2.0, 3.0};
+  S21Vector y(3, 1.0);
+
+  EXPECT_DOUBLE_EQ(x.Dot(y), 6.0);
+  EXPECT_DOUBLE_EQ(S21Vector({3.0, 4.0}).Norm(), 5.0);
+  y.Axpy(2.0, x);
+  EXPECT_TRUE(y == S21Vector({3.0, 5.0, 7.0}));
+  y.Xpby(x, -1.0);
+  EXPECT_TRUE(y == S21Vector({-2.0, -3.0, -4.0}));
+  EXPECT_THROW(x.Dot(S21Vector(2)), std::runtime_error);
+  EXPECT_THROW(x(3), std::runtime_error);
+
+  S21Matrix a = Sample(2, 3);
+  S21Vector ax = a * x;
+  for (int i = 0; i < 2; i++) {
+    EXPECT_DOUBLE_EQ(ax(i), a(i, 0) + 2.0 * a(i, 1) + 3.0 * a(i, 2));
+  }
+  S21Vector z(2, 1.0);
+  z.Gemv(2.0, a, x, 0.5);
+  EXPECT_DOUBLE_EQ(z(1), 2.0 * ax(1) + 0.5);
+  EXPECT_THROW(z.Gemv(1.0, a, z, 0.0), std::runtime_error);
+}
+
+TEST(Vector, Parallel) {
+  const int n = 300;
+  S21Matrix a(n, n);
+  S21Vector x(n);
+  for (int i = 0; i < n; i++) {
+    x(i) = (i % 7) - 3.0;
+    for (int j = 0; j < n; j++) a(i, j) = ((i + 2 * j) % 5) - 2.0;
+  }
+  S21Vector y = a * x;
+  for (int i = 0; i < n; i += 37) {
+    double expected = 0.0;
+    for (int j = 0; j < n; j++) expected += a(i, j) * x(j);
+    EXPECT_DOUBLE_EQ(y(i), expected);
+  }
+
+  S21Vector big(100000, 0.5);
+  EXPECT_DOUBLE_EQ(big.Dot(big), 25000.0);
+  big.Axpy(1.0, big);
+  EXPECT_DOUBLE_EQ(big(99999), 1.0);
+}
+
+namespace {
+
+// Tridiagonal -1, 2, -1 (1D Poisson), plus convection making it
+// nonsymmetric when skew != 0
+S21SparseMatrix Poisson(int n, double skew = 0.0) {
+  std::vector<S21SparseMatrix::Entry> entries;
+  for (int i = 0; i < n; i++) {
+    entries.push_back({i, i, 2.0});
+    if (i > 0) entries.push_back({i, i - 1, -1.0 - skew});
+    if (i + 1 < n) entries.push_back({i, i + 1, -1.0 + skew});
+  }
+  return S21SparseMatrix(n, entries);
+}
+
+double Residual(const S21LinearOperator& a, const S21Vector& b,
+                const S21Vector& x) {
+  S21Vector r(a.size());
+  a.Apply(x, r);
+  r.Xpby(b, -1.0);
+  return r.Norm() / b.Norm();
+}
+
+}  // namespace
+
+TEST(Solvers, SparseMatrix) {
+  S21SparseMatrix a(3, {{0, 0, 1.0}, {2, 1, 4.0}, {0, 0, 2.0}, {1, 2, -1.0}});
+  EXPECT_EQ(a.nonzeros(), 3);
+  EXPECT_DOUBLE_EQ(a(0, 0), 3.0);
+  EXPECT_DOUBLE_EQ(a(2, 1), 4.0);
+  EXPECT_DOUBLE_EQ(a(1, 1), 0.0);
+  EXPECT_THROW(a(3, 0), std::runtime_error);
+  EXPECT_THROW(S21SparseMatrix(2, {{2, 0, 1.0}}), std::runtime_error);
+
+  S21Matrix dense = Sample(4, 4);
+  S21SparseMatrix sparse(dense);
+  S21Vector x{1.0, -2.0, 0.5, 3.0};
+  S21Vector y(4);
+  sparse.Apply(x, y);
+  S21Vector expected = dense * x;
+  for (int i = 0; i < 4; i++) EXPECT_NEAR(y(i), expected(i), 1e-12);
+}
+
+TEST(Solvers, ConjugateGradient) {
+  const int n = 100;
+  S21SparseMatrix a = Poisson(n);
+  S21Vector b(n, 1.0);
+  S21ConjugateGradient cg;
+  int monitored = 0;
+  cg.options().monitor = [&](int, double) { monitored++; };
+
+  S21Vector x;
+  S21SolverResult plain = cg.Solve(a, b, x);
+  EXPECT_TRUE(plain.converged);
+  EXPECT_LT(Residual(a, b, x), 1e-9);
+  EXPECT_EQ(int(plain.history.size()), plain.iterations + 1);
+  EXPECT_EQ(monitored, plain.iterations + 1);
+
+  S21Vector y;
+  S21Ilu0Preconditioner ilu(a);
+  S21SolverResult preconditioned = cg.Solve(a, b, y, &ilu);
+  EXPECT_TRUE(preconditioned.converged);
+  // ILU(0) of a tridiagonal matrix is exact
+  EXPECT_LE(preconditioned.iterations, 2);
+  for (int i = 0; i < n; i++) EXPECT_NEAR(y(i), x(i), 1e-6);
+
+  // Warm start from the solution
+  S21SolverResult warm = cg.Solve(a, b, y, &ilu);
+  EXPECT_TRUE(warm.converged);
+  EXPECT_EQ(warm.iterations, 0);
+
+  S21Vector wrong(n + 1);
+  EXPECT_THROW(cg.Solve(a, b, wrong), std::runtime_error);
+}
+
+TEST(Solvers, Nonsymmetric) {
+  const int n = 80;
+  S21SparseMatrix a = Poisson(n, 0.4);
+  S21Vector b(n);
+  for (int i = 0; i < n; i++) b(i) = std::sin(0.1 * i);
+  S21JacobiPreconditioner jacobi(a);
+  S21SolverOptions options;
+  options.restart = 20;
+  options.max_iterations = 2000;
+
+  S21Gmres gmres(options);
+  S21Vector x;
+  EXPECT_TRUE(gmres.Solve(a, b, x, &jacobi).converged);
+  EXPECT_LT(Residual(a, b, x), 1e-9);
+
+  S21BiCgStab bicgstab(options);
+  S21Vector y;
+  EXPECT_TRUE(bicgstab.Solve(a, b, y, &jacobi).converged);
+  EXPECT_LT(Residual(a, b, y), 1e-9);
+
+  // Dense and matrix-free operators reach the same solution
+  S21Matrix dense(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) dense(i, j) = a(i, j);
+  }
+  S21DenseOperator dense_op(dense);
+  S21Vector z;
+  EXPECT_TRUE(gmres.Solve(dense_op, b, z, &jacobi).converged);
+  S21FunctionOperator free_op(
+      n, [&](const S21Vector& in, S21Vector& out) { a.Apply(in, out); });
+  S21Vector w;
+  EXPECT_TRUE(bicgstab.Solve(free_op, b, w).converged);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(z(i), x(i), 1e-6);
+    EXPECT_NEAR(w(i), x(i), 1e-6);
+  }
+}
+
+TEST(ErrorCodes, StatusInsteadOfExceptions) {
+  S21Matrix a = Sample(3, 3);
+  S21Matrix b(2, 2);
+  static_assert(noexcept(a.TrySumMatrix(b)), "TrySumMatrix must not throw");
+  static_assert(noexcept(a.TryMulMatrix(b)), "TryMulMatrix must not throw");
+
+  S21Matrix before(a);
+  EXPECT_EQ(a.TrySumMatrix(b), ERROR);
+  EXPECT_EQ(a.TrySubMatrix(b), ERROR);
+  EXPECT_EQ(a.TryMulMatrix(b), ERROR);
+  EXPECT_TRUE(a == before);
+
+  double value = -1.0;
+  EXPECT_EQ(a.TryGet(3, 0, value), ERROR);
+  EXPECT_EQ(a.TrySet(0, -1, 1.0), ERROR);
+  EXPECT_DOUBLE_EQ(value, -1.0);
+  EXPECT_EQ(a.TrySet(1, 2, 7.5), OK);
+  EXPECT_EQ(a.TryGet(1, 2, value), OK);
+  EXPECT_DOUBLE_EQ(value, 7.5);
+
+  EXPECT_EQ(S21Matrix(2, 3).TryDeterminant(value), ERROR);
+  S21Matrix square(before);
+  EXPECT_EQ(square.TryMulMatrix(before), OK);
+  ExpectNear(square, before * before);
+  EXPECT_EQ(square.TrySumMatrix(before), OK);
+  EXPECT_EQ(square.TrySubMatrix(before), OK);
+  ExpectNear(square, before * before);
+}
+
+TEST(ErrorCodes, DeterminantAndInverse) {
+  S21Matrix a = Sample(3, 3) * 0.0;
+  a(0, 0) = 2.0;
+  a(0, 1) = 1.0;
+  a(1, 1) = 3.0;
+  a(2, 0) = 1.0;
+  a(2, 2) = 4.0;
+  double det = 0.0;
+  EXPECT_EQ(a.TryDeterminant(det), OK);
+  EXPECT_NEAR(det, a.Determinant(), 1e-12);
+  EXPECT_NEAR(det, 24.0, 1e-12);
+
+  S21Matrix inverse;
+  EXPECT_EQ(a.TryInverseMatrix(inverse), OK);
+  S21Matrix identity = Sample(3, 3) * 0.0;
+  for (int i = 0; i < 3; i++) identity(i, i) = 1.0;
+  ExpectNear(a * inverse, identity);
+
+  S21Matrix singular = Sample(3, 3) * 0.0;
+  S21Matrix untouched(inverse);
+  EXPECT_EQ(singular.TryInverseMatrix(inverse), ERROR);
+  EXPECT_TRUE(inverse == untouched);
+  EXPECT_THROW(singular.InverseMatrix(), std::runtime_error);
+}
+
+namespace {
+
+// Diagonally dominant, so every leading minor is well away from zero
+S21Matrix Dominant(int size) {
+  S21Matrix result = Sample(size, size);
+  for (int i = 0; i < size; i++) result(i, i) += 4.0 * size;
+  return result;
+}
+
+S21Matrix PlusOuter(const S21Matrix& a, const S21Vector& u,
+                    const S21Vector& v, double sign = 1.0) {
+  S21Matrix result(a);
+  for (int i = 0; i < a.rows(); i++) {
+    for (int j = 0; j < a.cols(); j++) result(i, j) += sign * u(i) * v(j);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(Update, ShermanMorrisonAndWoodbury) {
+  const int n = 5;
+  S21Matrix a = Dominant(n);
+  S21UpdatableInverse updatable(a);
+  S21Vector u{1.0, -2.0, 0.5, 3.0, 1.5};
+  S21Vector v{0.5, 1.0, -1.0, 2.0, 0.25};
+  updatable.Update(u, v);
+  S21Matrix updated = PlusOuter(a, u, v);
+  ExpectNear(updatable.inverse(), S21Matrix(updated).InverseMatrix());
+  EXPECT_NEAR(updatable.determinant(), updated.Determinant(),
+              1e-9 * std::fabs(updated.Determinant()));
+
+  S21Matrix left = Sample(n, 2);
+  S21Matrix right = Sample(n, 2) * 0.25;
+  updatable.Update(left, right);
+  updated += left * right.Transpose();
+  ExpectNear(updatable.inverse(), S21Matrix(updated).InverseMatrix());
+  EXPECT_NEAR(updatable.determinant(), updated.Determinant(),
+              1e-9 * std::fabs(updated.Determinant()));
+  S21Vector x;
+  updatable.Solve(u, x);
+  S21Vector back = updated * x;
+  for (int i = 0; i < n; i++) EXPECT_NEAR(back(i), u(i), 1e-9);
+
+  // Removing the (0, 0) element of the identity makes it singular
+  S21Matrix identity = Sample(2, 2) * 0.0;
+  identity(0, 0) = identity(1, 1) = 1.0;
+  S21UpdatableInverse singular(identity);
+  EXPECT_THROW(singular.Update(S21Vector{-1.0, 0.0}, S21Vector{1.0, 0.0}),
+               std::runtime_error);
+  ExpectNear(singular.inverse(), identity);
+  EXPECT_THROW(singular.Update(S21Vector{1.0}, S21Vector{1.0}),
+               std::runtime_error);
+}
+
+TEST(Update, LuRankOne) {
+  const int n = 6;
+  S21Matrix a = Sample(n, n);
+  for (int i = 0; i < n; i++) a(i, (i + 2) % n) += 10.0;  // Forces pivoting
+  S21LuFactorization lu(a);
+  S21Vector u(n), v(n);
+  for (int i = 0; i < n; i++) {
+    u(i) = 0.5 * i - 1.0;
+    v(i) = (i % 3) - 0.75;
+  }
+  lu.Update(u, v);
+  lu.Update(v, u);
+  S21Matrix updated = PlusOuter(PlusOuter(a, u, v), v, u);
+
+  S21Matrix permuted(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      permuted(i, j) = updated(lu.permutation()[i], j);
+    }
+  }
+  ExpectNear(lu.Lower() * lu.Upper(), permuted);
+  EXPECT_NEAR(lu.Determinant(), updated.Determinant(),
+              1e-9 * std::fabs(updated.Determinant()));
+  S21Vector x;
+  lu.Solve(u, x);
+  S21Vector back = updated * x;
+  for (int i = 0; i < n; i++) EXPECT_NEAR(back(i), u(i), 1e-9);
+}
+
+TEST(Update, SingularAsForS21Matrix) {
+  S21Matrix a(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) a(i, j) = 3 * i + j + 1;
+  }
+  EXPECT_THROW(a.InverseMatrix(), std::runtime_error);
+  EXPECT_THROW(S21LuFactorization{a}, std::runtime_error);
+  EXPECT_THROW(S21UpdatableInverse{a}, std::runtime_error);
+
+  // I + u v^T with v^T u = 1 up to rounding
+  S21Matrix identity = Sample(3, 3) * 0.0;
+  for (int i = 0; i < 3; i++) identity(i, i) = 1.0;
+  S21Vector u{-0.3, -0.6, -0.1}, v{1.0, 1.0, 1.0};
+  S21UpdatableInverse inverse(identity);
+  EXPECT_THROW(inverse.Update(u, v), std::runtime_error);
+  S21LuFactorization lu(identity);
+  EXPECT_THROW(lu.Update(u, v), std::runtime_error);
+  EXPECT_DOUBLE_EQ(lu.Determinant(), 1.0);
+}
+
+TEST(Update, CholeskyUpdateDowndate) {
+  const int n = 5;
+  S21Matrix b = Sample(n, n);
+  S21Matrix a = b * b.Transpose();
+  for (int i = 0; i < n; i++) a(i, i) += 1.0;
+  S21CholeskyFactorization cholesky(a);
+  ExpectNear(cholesky.lower() * cholesky.lower().Transpose(), a);
+
+  S21Vector x{1.0, 0.5, -0.5, 2.0, -1.0};
+  cholesky.Update(x);
+  S21Matrix updated = PlusOuter(a, x, x);
+  ExpectNear(cholesky.lower() * cholesky.lower().Transpose(), updated);
+  EXPECT_NEAR(cholesky.Determinant(), updated.Determinant(),
+              1e-9 * updated.Determinant());
+
+  cholesky.Downdate(x);
+  ExpectNear(cholesky.lower() * cholesky.lower().Transpose(), a);
+  S21Vector solution;
+  cholesky.Solve(x, solution);
+  S21Vector back = a * solution;
+  for (int i = 0; i < n; i++) EXPECT_NEAR(back(i), x(i), 1e-9);
+
+  S21Matrix before(cholesky.lower());
+  x.MulNumber(100.0);
+  EXPECT_THROW(cholesky.Downdate(x), std::runtime_error);
+  EXPECT_TRUE(cholesky.lower() == before);
+  EXPECT_THROW(S21CholeskyFactorization(a * -1.0), std::runtime_error);
+}
+
+TEST(Reduce, Kernels) {
+  S21Matrix a = Sample(3, 4);
+  S21Vector rows = S21Reduce::RowSums(a);
+  S21Vector cols = S21Reduce::ColSums(a);
+  double total = 0.0;
+  for (int i = 0; i < 3; i++) {
+    double sum = 0.0;
+    for (int j = 0; j < 4; j++) sum += a(i, j);
+    EXPECT_DOUBLE_EQ(rows(i), sum);
+    total += sum;
+  }
+  for (int j = 0; j < 4; j++) {
+    EXPECT_DOUBLE_EQ(cols(j), a(0, j) + a(1, j) + a(2, j));
+  }
+  EXPECT_DOUBLE_EQ(S21Reduce::Sum(a), total);
+  EXPECT_DOUBLE_EQ(S21Reduce::Sum(a, S21Reduce::kKahan), total);
+  EXPECT_DOUBLE_EQ(S21Reduce::FrobeniusNorm(a), a.Norm());
+  EXPECT_THROW(S21Reduce::Trace(a), std::runtime_error);
+  EXPECT_DOUBLE_EQ(S21Reduce::Trace(Sample(3, 3)), -4.5);
+
+  a(2, 1) = -9.0;
+  a(0, 3) = 9.0;
+  S21Reduce::Location max = S21Reduce::ArgMaxAbs(a);
+  EXPECT_EQ(max.row, 0);  // First of the tied elements
+  EXPECT_EQ(max.col, 3);
+  EXPECT_DOUBLE_EQ(max.value, 9.0);
+  EXPECT_DOUBLE_EQ(S21Reduce::MaxAbs(a), 9.0);
+  EXPECT_THROW(S21Reduce::ArgMaxAbs(S21Matrix()), std::runtime_error);
+
+  S21Matrix b(a);
+  S21Reduce::SwapRows(b, 0, 2);
+  S21Reduce::ScaleRow(b, 1, 2.0);
+  S21Reduce::AddRow(b, 0, 2, -1.0);
+  for (int j = 0; j < 4; j++) {
+    EXPECT_DOUBLE_EQ(b(0, j), a(2, j) - a(0, j));
+    EXPECT_DOUBLE_EQ(b(1, j), 2.0 * a(1, j));
+    EXPECT_DOUBLE_EQ(b(2, j), a(0, j));
+  }
+  EXPECT_THROW(S21Reduce::SwapRows(b, 0, 3), std::runtime_error);
+}
+
+TEST(Reduce, AccurateAndParallel) {
+  // 1 followed by many terms below half an ulp of 1: a naive running sum
+  // drops every one of them
+  const int n = 100000;
+  S21Matrix a(1, n);
+  double* x = a.mutable_row(0);
+  x[0] = 1.0;
+  for (int j = 1; j < n; j++) x[j] = 1e-16;
+  double exact = 1.0 + (n - 1) * 1e-16;
+  EXPECT_NEAR(S21Reduce::Sum(a, S21Reduce::kKahan), exact, 1e-15);
+  EXPECT_NEAR(S21Reduce::Sum(a), exact, 1e-14);
+  EXPECT_NEAR(S21Reduce::RowSums(a, S21Reduce::kKahan)(0), exact, 1e-15);
+
+  S21Matrix big(400, 300);
+  for (int i = 0; i < big.rows(); i++) {
+    double* row = big.mutable_row(i);
+    for (int j = 0; j < big.cols(); j++) row[j] = ((i * 31 + j) % 17) - 8.0;
+  }
+  big(250, 7) = -100.0;
+  big(310, 2) = 100.0;
+  S21Reduce::Location max = S21Reduce::ArgMaxAbs(big);
+  EXPECT_EQ(max.row, 250);
+  EXPECT_EQ(max.col, 7);
+  EXPECT_NEAR(S21Reduce::FrobeniusNorm(big), big.Norm(), 1e-9);
+  S21Vector cols = S21Reduce::ColSums(big);
+  S21Vector rows = S21Reduce::RowSums(big);
+  double by_cols = 0.0, by_rows = 0.0;
+  for (int j = 0; j < big.cols(); j++) by_cols += cols(j);
+  for (int i = 0; i < big.rows(); i++) by_rows += rows(i);
+  EXPECT_DOUBLE_EQ(by_cols, S21Reduce::Sum(big));
+  EXPECT_DOUBLE_EQ(by_rows, S21Reduce::Sum(big));
+}
+
+TEST(Elementwise, ApplyMapZip) {
+  S21Matrix a = Sample(3, 4);
+  S21Matrix b = Sample(3, 4) * 0.5;
+  auto relu = [](double x) { return x > 0.0 ? x : 0.0; };
+
+  S21Matrix mapped = Map(a, relu);
+  S21Matrix zipped = Zip(a, b, [](double x, double y) { return x * y; });
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_DOUBLE_EQ(mapped(i, j), relu(a(i, j)));
+      EXPECT_DOUBLE_EQ(zipped(i, j), a(i, j) * b(i, j));
+    }
+  }
+  EXPECT_THROW(Zip(a, Sample(4, 3), [](double x, double) { return x; }),
+               std::runtime_error);
+
+  double norm = a.Norm();
+  Apply(a, [](double x) { return std::min(1.0, std::max(-1.0, x)); });
+  EXPECT_LT(a.Norm(), norm);  // Cached norm was dropped
+  EXPECT_TRUE(Map(S21Matrix(), relu) == S21Matrix());
+}
+
+TEST(Elementwise, FusedWithOperators) {
+  S21Matrix a = Sample(4, 4);
+  S21Matrix b = Sample(4, 4) * 2.0;
+  S21Matrix c = Sample(4, 4) * -1.0;
+  S21Matrix expected = Map(a + b - c * 3.0, [](double x) { return x * x; });
+
+  // Temporaries on the left are updated in place, down to the final Map
+  S21Matrix sum = a + b;
+  const double* storage = sum.row(0);
+  S21Matrix result =
+      Map(std::move(sum) - c * 3.0, [](double x) { return x * x; });
+  EXPECT_EQ(result.row(0), storage);
+  EXPECT_TRUE(result == expected);
+
+  S21Matrix scaled = a * 2.0;
+  storage = scaled.row(0);
+  S21Matrix zipped =
+      Zip(std::move(scaled), b, [](double x, double y) { return x - y; });
+  EXPECT_EQ(zipped.row(0), storage);
+  EXPECT_DOUBLE_EQ(S21Reduce::MaxAbs(zipped), 0.0);
+}
+
+TEST(Elementwise, Parallel) {
+  S21Matrix a(300, 300);
+  Apply(a, [](double) { return 1.5; });
+  S21Matrix b = Map(a, [](double x) { return -2.0 * x; });
+  S21Matrix c = Zip(a, b, [](double x, double y) { return x + y; });
+  EXPECT_DOUBLE_EQ(S21Reduce::Sum(c), -1.5 * 300 * 300);
+  EXPECT_DOUBLE_EQ(S21Reduce::MaxAbs(c - S21Matrix(c)), 0.0);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
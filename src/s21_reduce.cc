@@ -0,0 +1,186 @@
+#include "s21_reduce.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_executor.h"
+
+namespace {
+
+// Below this many elements reductions stay on the calling thread
+const size_t kParallelMin = 1 << 15;
+// Large reductions are split into this many fixed parts, whatever the
+// number of threads, and the partial results are summed pairwise
+const int kParts = 64;
+
+size_t Elements(const S21Matrix& a) { return size_t(a.rows()) * a.cols(); }
+
+// Rows are stored back to back, so the whole matrix is one array
+const double* Data(const S21Matrix& a) {
+  return a.rows() > 0 ? a.row(0) : nullptr;
+}
+
+// Runs part(first, count, index) over kParts slices of [0, n), in parallel
+template <class F>
+void ForEachPart(size_t n, F part) {
+  size_t step = (n + kParts - 1) / kParts;
+  S21Executor::Default().ParallelFor(0, kParts, 1, [&](int begin, int end) {
+    for (int index = begin; index < end; index++) {
+      size_t first = std::min(n, index * step);
+      part(first, std::min(n, first + step) - first, index);
+    }
+  });
+}
+
+double KahanSum(const double* x, size_t n) {
+  S21KahanSum sum;
+  for (size_t i = 0; i < n; i++) sum.Add(x[i]);
+  return sum.value();
+}
+
+// Sum of f(x[i]) over [0, n); parallel tree reduction above kParallelMin
+template <class F>
+double Reduce(const double* x, size_t n, S21Reduce::Summation summation,
+              F f) {
+  auto leaf = [&](const double* begin, size_t count) {
+    if (summation == S21Reduce::kPairwise) {
+      return S21PairwiseSum(begin, count, f);
+    }
+    S21KahanSum sum;
+    for (size_t i = 0; i < count; i++) sum.Add(f(begin[i]));
+    return sum.value();
+  };
+  if (n < kParallelMin) return leaf(x, n);
+  double partial[kParts];
+  ForEachPart(n, [&](size_t first, size_t count, int index) {
+    partial[index] = leaf(x + first, count);
+  });
+  return summation == S21Reduce::kPairwise ? S21PairwiseSum(partial, kParts)
+                                           : KahanSum(partial, kParts);
+}
+
+void CheckRow(const S21Matrix& a, int row) {
+  if (row < 0 || row >= a.rows()) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+}
+
+}  // namespace
+
+double S21Reduce::Sum(const S21Matrix& a, Summation summation) {
+  return Reduce(Data(a), Elements(a), summation,
+                [](double value) { return value; });
+}
+
+S21Vector S21Reduce::RowSums(const S21Matrix& a, Summation summation) {
+  S21Vector result(a.rows());
+  double* sums = result.data();
+  size_t cols = a.cols();
+  auto rows = [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      sums[i] = summation == kPairwise ? S21PairwiseSum(a.row(i), cols)
+                                       : KahanSum(a.row(i), cols);
+    }
+  };
+  if (Elements(a) < kParallelMin) {
+    rows(0, a.rows());
+  } else {
+    int grain = int(std::max<size_t>(1, kParallelMin / 2 / cols));
+    S21Executor::Default().ParallelFor(0, a.rows(), grain, rows);
+  }
+  return result;
+}
+
+// Every thread owns a slice of columns and walks all rows over it, so the
+// inner loop is contiguous and the accumulators need no synchronization
+S21Vector S21Reduce::ColSums(const S21Matrix& a) {
+  int cols = a.cols();
+  S21Vector result(cols);
+  S21Vector compensation(cols);
+  double* sums = result.data();
+  double* error = compensation.data();
+  auto slice = [&](int begin, int end) {
+    for (int i = 0; i < a.rows(); i++) {
+      const double* row = a.row(i);
+      for (int j = begin; j < end; j++) {
+        double sum = sums[j] + row[j];
+        error[j] += std::fabs(sums[j]) >= std::fabs(row[j])
+                        ? (sums[j] - sum) + row[j]
+                        : (row[j] - sum) + sums[j];
+        sums[j] = sum;
+      }
+    }
+    for (int j = begin; j < end; j++) sums[j] += error[j];
+  };
+  if (Elements(a) < kParallelMin) {
+    slice(0, cols);
+  } else {
+    int grain = std::max(8, int(kParallelMin / 2 / std::max(a.rows(), 1)));
+    S21Executor::Default().ParallelFor(0, cols, grain, slice);
+  }
+  return result;
+}
+
+double S21Reduce::Trace(const S21Matrix& a) {
+  if (a.rows() != a.cols()) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+  S21KahanSum sum;
+  for (int i = 0; i < a.rows(); i++) sum.Add(a.row(i)[i]);
+  return sum.value();
+}
+
+double S21Reduce::FrobeniusNorm(const S21Matrix& a) {
+  return std::sqrt(Reduce(Data(a), Elements(a), kPairwise,
+                          [](double value) { return value * value; }));
+}
+
+double S21Reduce::MaxAbs(const S21Matrix& a) {
+  return Elements(a) == 0 ? 0.0 : std::fabs(ArgMaxAbs(a).value);
+}
+
+S21Reduce::Location S21Reduce::ArgMaxAbs(const S21Matrix& a) {
+  size_t n = Elements(a);
+  if (n == 0) throw std::runtime_error("Error: The matrix is empty");
+  const double* x = Data(a);
+  size_t best = 0;
+  if (n < kParallelMin) {
+    best = S21ArgMaxAbs(x, n);
+  } else {
+    size_t partial[kParts];
+    ForEachPart(n, [&](size_t first, size_t count, int index) {
+      partial[index] = count ? first + S21ArgMaxAbs(x + first, count) : first;
+    });
+    // Parts are in order, so strict comparison keeps the first maximum
+    best = partial[0];
+    for (int i = 1; i < kParts; i++) {
+      if (partial[i] < n && std::fabs(x[partial[i]]) > std::fabs(x[best])) {
+        best = partial[i];
+      }
+    }
+  }
+  return Location{int(best / a.cols()), int(best % a.cols()), x[best]};
+}
+
+void S21Reduce::SwapRows(S21Matrix& a, int first, int second) {
+  CheckRow(a, first);
+  CheckRow(a, second);
+  if (first == second) return;
+  std::swap_ranges(a.mutable_row(first), a.mutable_row(first) + a.cols(),
+                   a.mutable_row(second));
+}
+
+void S21Reduce::ScaleRow(S21Matrix& a, int row, double factor) {
+  CheckRow(a, row);
+  double* x = a.mutable_row(row);
+  for (int j = 0; j < a.cols(); j++) x[j] *= factor;
+}
+
+void S21Reduce::AddRow(S21Matrix& a, int target, int source, double factor) {
+  CheckRow(a, target);
+  CheckRow(a, source);
+  double* y = a.mutable_row(target);
+  const double* x = a.row(source);
+  for (int j = 0; j < a.cols(); j++) y[j] += factor * x[j];
+}
@@ -0,0 +1,108 @@
+#ifndef S21_REDUCE_H_
+#define S21_REDUCE_H_
+
+// Reductions and row operations on S21Matrix.
+//
+// The inline kernels below work on raw strided arrays and are what the core
+// library uses for Norm() and the LU pivot search; they need nothing beyond
+// this header. S21Reduce builds matrix-level reductions on them and splits
+// large matrices into a fixed number of parts reduced on
+// S21Executor::Default(), so results do not depend on the thread count.
+
+#include <cmath>
+#include <cstddef>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+// Pairwise (cascade) summation of f(x[i]): the rounding error grows as
+// O(log n) rather than O(n). Leaves of up to 128 elements are summed with
+// four independent accumulators, so they vectorize without -ffast-math.
+template <class F>
+double S21PairwiseSum(const double* x, size_t n, F f) {
+  if (n > 128) {
+    size_t half = n / 2;
+    return S21PairwiseSum(x, half, f) + S21PairwiseSum(x + half, n - half, f);
+  }
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  size_t i = 0;
+  size_t blocks = n - n % 4;
+  for (; i < blocks; i += 4) {
+    s0 += f(x[i]);
+    s1 += f(x[i + 1]);
+    s2 += f(x[i + 2]);
+    s3 += f(x[i + 3]);
+  }
+  for (; i < n; i++) s0 += f(x[i]);
+  return (s0 + s1) + (s2 + s3);
+}
+
+inline double S21PairwiseSum(const double* x, size_t n) {
+  return S21PairwiseSum(x, n, [](double value) { return value; });
+}
+
+// Compensated (Kahan-Babuska-Neumaier) accumulator: the error stays O(1)
+// ulps whatever the length, at about four times the cost of a plain sum
+class S21KahanSum {
+ public:
+  void Add(double value) {
+    double sum = sum_ + value;
+    if (std::fabs(sum_) >= std::fabs(value)) {
+      compensation_ += (sum_ - sum) + value;
+    } else {
+      compensation_ += (value - sum) + sum_;
+    }
+    sum_ = sum;
+  }
+  double value() const { return sum_ + compensation_; }
+
+ private:
+  double sum_ = 0.0;
+  double compensation_ = 0.0;
+};
+
+// Position of the first element of largest magnitude among
+// x[0], x[stride], ..., x[(n - 1) * stride]; n must be positive
+inline size_t S21ArgMaxAbs(const double* x, size_t n, size_t stride = 1) {
+  size_t best = 0;
+  double best_value = std::fabs(x[0]);
+  for (size_t i = 1; i < n; i++) {
+    double value = std::fabs(x[i * stride]);
+    if (value > best_value) {
+      best = i;
+      best_value = value;
+    }
+  }
+  return best;
+}
+
+class S21Reduce {
+ public:
+  enum Summation { kPairwise, kKahan };
+
+  struct Location {
+    int row, col;
+    double value;
+  };
+
+  static double Sum(const S21Matrix& a, Summation summation = kPairwise);
+  static S21Vector RowSums(const S21Matrix& a, Summation summation = kPairwise);
+  // Compensated, streaming over the rows in storage order
+  static S21Vector ColSums(const S21Matrix& a);
+  // Throws if a is not square
+  static double Trace(const S21Matrix& a);
+  // Equals a.Norm() up to the rounding of the parallel split
+  static double FrobeniusNorm(const S21Matrix& a);
+  static double MaxAbs(const S21Matrix& a);
+  // First element of largest magnitude in row-major order. Throws if a is
+  // empty.
+  static Location ArgMaxAbs(const S21Matrix& a);
+
+  // Row operations, as used by elimination. Indices are checked.
+  static void SwapRows(S21Matrix& a, int first, int second);
+  static void ScaleRow(S21Matrix& a, int row, double factor);
+  // Row target += factor * row source
+  static void AddRow(S21Matrix& a, int target, int source, double factor);
+};
+
+#endif  // S21_REDUCE_H_
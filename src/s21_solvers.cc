@@ -0,0 +1,419 @@
+#include "s21_solvers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+void CheckSystem(const S21LinearOperator& a, const S21Vector& b,
+                 S21Vector& x) {
+  if (b.size() != a.size()) {
+    throw std::runtime_error(
+        "Error: The right-hand side must match the operator size");
+  }
+  if (x.size() == 0) x.Resize(a.size());  // No guess: start from zero
+  if (x.size() != a.size()) {
+    throw std::runtime_error(
+        "Error: The initial guess must match the operator size");
+  }
+}
+
+// r = b - a * x
+void Residual(const S21LinearOperator& a, const S21Vector& b,
+              const S21Vector& x, S21Vector& r) {
+  a.Apply(x, r);
+  r.Xpby(b, -1.0);
+}
+
+}  // namespace
+
+// S21DenseOperator
+
+S21DenseOperator::S21DenseOperator(const S21Matrix& matrix) : matrix_(matrix) {
+  if (matrix.rows() != matrix.cols()) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+}
+
+void S21DenseOperator::Apply(const S21Vector& x, S21Vector& y) const {
+  y.Gemv(1.0, matrix_, x, 0.0);
+}
+
+// S21FunctionOperator
+
+S21FunctionOperator::S21FunctionOperator(int size, Function apply)
+    : size_(size), apply_(std::move(apply)) {}
+
+void S21FunctionOperator::Apply(const S21Vector& x, S21Vector& y) const {
+  apply_(x, y);
+}
+
+// S21SparseMatrix
+
+S21SparseMatrix::S21SparseMatrix(int size, std::vector<Entry> entries)
+    : size_(size), row_start_(size + 1, 0) {
+  if (size <= 0) {
+    throw std::runtime_error(
+        "Error: The size of the matrix must be greater than zero");
+  }
+  for (const Entry& entry : entries) {
+    if (entry.row < 0 || entry.row >= size || entry.col < 0 ||
+        entry.col >= size) {
+      throw std::runtime_error("Error: Index is outside the matrix");
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& lhs, const Entry& rhs) {
+              return lhs.row != rhs.row ? lhs.row < rhs.row
+                                        : lhs.col < rhs.col;
+            });
+  for (size_t i = 0; i < entries.size(); i++) {
+    const Entry& entry = entries[i];
+    if (i > 0 && entry.row == entries[i - 1].row &&
+        entry.col == entries[i - 1].col) {
+      values_.back() += entry.value;
+    } else {
+      columns_.push_back(entry.col);
+      values_.push_back(entry.value);
+      row_start_[entry.row + 1]++;
+    }
+  }
+  for (int i = 0; i < size; i++) row_start_[i + 1] += row_start_[i];
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense)
+    : size_(dense.rows()), row_start_(dense.rows() + 1, 0) {
+  if (dense.rows() != dense.cols()) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+  for (int i = 0; i < size_; i++) {
+    const double* row = dense.row(i);
+    for (int j = 0; j < size_; j++) {
+      if (row[j] != 0.0) {
+        columns_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    row_start_[i + 1] = int(values_.size());
+  }
+}
+
+void S21SparseMatrix::Apply(const S21Vector& x, S21Vector& y) const {
+  if (x.size() != size_ || y.size() != size_) {
+    throw std::runtime_error(
+        "Error: The matrix and vector dimensions do not match");
+  }
+  const double* src = x.data();
+  double* dst = y.data();
+  for (int i = 0; i < size_; i++) {
+    double sum = 0.0;
+    for (int p = row_start_[i]; p < row_start_[i + 1]; p++) {
+      sum += values_[p] * src[columns_[p]];
+    }
+    dst[i] = sum;
+  }
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  auto begin = columns_.begin() + row_start_[row];
+  auto end = columns_.begin() + row_start_[row + 1];
+  auto it = std::lower_bound(begin, end, col);
+  return it != end && *it == col ? values_[it - columns_.begin()] : 0.0;
+}
+
+// S21JacobiPreconditioner
+
+S21JacobiPreconditioner::S21JacobiPreconditioner(const S21Matrix& a)
+    : inverse_diagonal_(a.rows()) {
+  if (a.rows() != a.cols()) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+  for (int i = 0; i < a.rows(); i++) inverse_diagonal_(i) = a.row(i)[i];
+  Invert();
+}
+
+S21JacobiPreconditioner::S21JacobiPreconditioner(const S21SparseMatrix& a)
+    : inverse_diagonal_(a.size()) {
+  for (int i = 0; i < a.size(); i++) inverse_diagonal_(i) = a(i, i);
+  Invert();
+}
+
+void S21JacobiPreconditioner::Invert() {
+  double* d = inverse_diagonal_.data();
+  for (int i = 0; i < inverse_diagonal_.size(); i++) {
+    if (d[i] == 0.0) {
+      throw std::runtime_error("Error: Zero on the diagonal");
+    }
+    d[i] = 1.0 / d[i];
+  }
+}
+
+void S21JacobiPreconditioner::Apply(const S21Vector& r, S21Vector& z) const {
+  const double* d = inverse_diagonal_.data();
+  const double* src = r.data();
+  double* dst = z.data();
+  for (int i = 0; i < r.size(); i++) dst[i] = d[i] * src[i];
+}
+
+// S21Ilu0Preconditioner
+
+S21Ilu0Preconditioner::S21Ilu0Preconditioner(const S21SparseMatrix& a)
+    : size_(a.size()),
+      row_start_(a.row_start()),
+      columns_(a.columns()),
+      diagonal_(a.size(), -1),
+      values_(a.values()) {
+  for (int i = 0; i < size_; i++) {
+    for (int p = row_start_[i]; p < row_start_[i + 1]; p++) {
+      if (columns_[p] == i) diagonal_[i] = p;
+    }
+    if (diagonal_[i] < 0) {
+      throw std::runtime_error("Error: Zero on the diagonal");
+    }
+  }
+  // IKJ elimination restricted to the pattern of a; position maps the
+  // columns of the current row to their slots
+  std::vector<int> position(size_, -1);
+  for (int i = 0; i < size_; i++) {
+    for (int p = row_start_[i]; p < row_start_[i + 1]; p++) {
+      position[columns_[p]] = p;
+    }
+    for (int p = row_start_[i]; p < diagonal_[i]; p++) {
+      int k = columns_[p];
+      values_[p] /= values_[diagonal_[k]];
+      for (int q = diagonal_[k] + 1; q < row_start_[k + 1]; q++) {
+        int slot = position[columns_[q]];
+        if (slot >= 0) values_[slot] -= values_[p] * values_[q];
+      }
+    }
+    for (int p = row_start_[i]; p < row_start_[i + 1]; p++) {
+      position[columns_[p]] = -1;
+    }
+    if (values_[diagonal_[i]] == 0.0) {
+      throw std::runtime_error("Error: Zero pivot in the incomplete LU");
+    }
+  }
+}
+
+void S21Ilu0Preconditioner::Apply(const S21Vector& r, S21Vector& z) const {
+  const double* src = r.data();
+  double* dst = z.data();
+  for (int i = 0; i < size_; i++) {
+    double sum = src[i];
+    for (int p = row_start_[i]; p < diagonal_[i]; p++) {
+      sum -= values_[p] * dst[columns_[p]];
+    }
+    dst[i] = sum;
+  }
+  for (int i = size_ - 1; i >= 0; i--) {
+    double sum = dst[i];
+    for (int p = diagonal_[i] + 1; p < row_start_[i + 1]; p++) {
+      sum -= values_[p] * dst[columns_[p]];
+    }
+    dst[i] = sum / values_[diagonal_[i]];
+  }
+}
+
+// S21KrylovSolver
+
+bool S21KrylovSolver::Report(S21SolverResult& result, double residual) const {
+  result.residual = residual;
+  result.history.push_back(residual);
+  if (options_.monitor) options_.monitor(result.iterations, residual);
+  result.converged = residual <= options_.tolerance;
+  return result.converged;
+}
+
+void S21KrylovSolver::Precondition(const S21Preconditioner* preconditioner,
+                                   const S21Vector& r, S21Vector& z) {
+  if (preconditioner) {
+    preconditioner->Apply(r, z);
+  } else {
+    z = r;
+  }
+}
+
+// S21ConjugateGradient
+
+S21SolverResult S21ConjugateGradient::Solve(
+    const S21LinearOperator& a, const S21Vector& b, S21Vector& x,
+    const S21Preconditioner* preconditioner) {
+  CheckSystem(a, b, x);
+  int n = a.size();
+  r_.Resize(n);
+  z_.Resize(n);
+  p_.Resize(n);
+  q_.Resize(n);
+  S21SolverResult result;
+  result.history.reserve(options_.max_iterations + 1);
+
+  double b_norm = b.Norm();
+  if (b_norm == 0.0) b_norm = 1.0;
+  Residual(a, b, x, r_);
+  if (Report(result, r_.Norm() / b_norm)) return result;
+  Precondition(preconditioner, r_, z_);
+  p_ = z_;
+  double rz = r_.Dot(z_);
+
+  while (result.iterations < options_.max_iterations) {
+    a.Apply(p_, q_);
+    double pq = p_.Dot(q_);
+    if (pq == 0.0) break;
+    double alpha = rz / pq;
+    x.Axpy(alpha, p_);
+    r_.Axpy(-alpha, q_);
+    result.iterations++;
+    if (Report(result, r_.Norm() / b_norm)) break;
+    Precondition(preconditioner, r_, z_);
+    double rz_next = r_.Dot(z_);
+    p_.Xpby(z_, rz_next / rz);
+    rz = rz_next;
+  }
+  return result;
+}
+
+// S21Gmres
+
+S21SolverResult S21Gmres::Solve(const S21LinearOperator& a,
+                                const S21Vector& b, S21Vector& x,
+                                const S21Preconditioner* preconditioner) {
+  CheckSystem(a, b, x);
+  int n = a.size();
+  int m = std::max(1, std::min(options_.restart, n));
+  basis_.resize(m + 1);
+  for (S21Vector& v : basis_) v.Resize(n);
+  r_.Resize(n);
+  w_.Resize(n);
+  z_.Resize(n);
+  hessenberg_.assign(size_t(m + 1) * m, 0.0);
+  cs_.assign(m, 0.0);
+  sn_.assign(m, 0.0);
+  g_.assign(m + 1, 0.0);
+  y_.assign(m, 0.0);
+  auto h = [&](int i, int j) -> double& { return hessenberg_[i * m + j]; };
+  S21SolverResult result;
+  result.history.reserve(options_.max_iterations + 1);
+
+  double b_norm = b.Norm();
+  if (b_norm == 0.0) b_norm = 1.0;
+  Residual(a, b, x, r_);
+  double beta = r_.Norm();
+  bool done = Report(result, beta / b_norm);
+
+  while (!done && result.iterations < options_.max_iterations) {
+    basis_[0] = r_;
+    basis_[0].MulNumber(1.0 / beta);
+    std::fill(g_.begin(), g_.end(), 0.0);
+    g_[0] = beta;
+    int k = 0;
+    while (k < m && result.iterations < options_.max_iterations) {
+      int j = k++;
+      Precondition(preconditioner, basis_[j], z_);
+      a.Apply(z_, w_);
+      // Modified Gram-Schmidt
+      for (int i = 0; i <= j; i++) {
+        h(i, j) = w_.Dot(basis_[i]);
+        w_.Axpy(-h(i, j), basis_[i]);
+      }
+      h(j + 1, j) = w_.Norm();
+      bool breakdown = h(j + 1, j) == 0.0;
+      if (!breakdown) {
+        basis_[j + 1] = w_;
+        basis_[j + 1].MulNumber(1.0 / h(j + 1, j));
+      }
+      // Givens rotations keep the Hessenberg matrix upper triangular
+      for (int i = 0; i < j; i++) {
+        double upper = cs_[i] * h(i, j) + sn_[i] * h(i + 1, j);
+        h(i + 1, j) = -sn_[i] * h(i, j) + cs_[i] * h(i + 1, j);
+        h(i, j) = upper;
+      }
+      double norm = std::hypot(h(j, j), h(j + 1, j));
+      cs_[j] = h(j, j) / norm;
+      sn_[j] = h(j + 1, j) / norm;
+      h(j, j) = norm;
+      h(j + 1, j) = 0.0;
+      g_[j + 1] = -sn_[j] * g_[j];
+      g_[j] *= cs_[j];
+      result.iterations++;
+      done = Report(result, std::fabs(g_[j + 1]) / b_norm);
+      if (done || breakdown) break;
+    }
+    // x += M^-1 * V * y, where H * y = g
+    for (int i = k - 1; i >= 0; i--) {
+      double sum = g_[i];
+      for (int l = i + 1; l < k; l++) sum -= h(i, l) * y_[l];
+      y_[i] = sum / h(i, i);
+    }
+    w_.Fill(0.0);
+    for (int i = 0; i < k; i++) w_.Axpy(y_[i], basis_[i]);
+    Precondition(preconditioner, w_, z_);
+    x.Axpy(1.0, z_);
+    Residual(a, b, x, r_);
+    beta = r_.Norm();
+    if (beta == 0.0) break;
+  }
+  return result;
+}
+
+// S21BiCgStab
+
+S21SolverResult S21BiCgStab::Solve(const S21LinearOperator& a,
+                                   const S21Vector& b, S21Vector& x,
+                                   const S21Preconditioner* preconditioner) {
+  CheckSystem(a, b, x);
+  int n = a.size();
+  for (S21Vector* v : {&r_, &r0_, &p_, &v_, &s_, &t_, &p_hat_, &s_hat_}) {
+    v->Resize(n);
+  }
+  S21SolverResult result;
+  result.history.reserve(options_.max_iterations + 1);
+
+  double b_norm = b.Norm();
+  if (b_norm == 0.0) b_norm = 1.0;
+  Residual(a, b, x, r_);
+  if (Report(result, r_.Norm() / b_norm)) return result;
+  r0_ = r_;
+  double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+  while (result.iterations < options_.max_iterations) {
+    double rho_next = r0_.Dot(r_);
+    if (rho_next == 0.0) break;
+    if (result.iterations == 0) {
+      p_ = r_;
+    } else {
+      // p = r + beta * (p - omega * v)
+      p_.Axpy(-omega, v_);
+      p_.Xpby(r_, (rho_next / rho) * (alpha / omega));
+    }
+    Precondition(preconditioner, p_, p_hat_);
+    a.Apply(p_hat_, v_);
+    double r0v = r0_.Dot(v_);
+    if (r0v == 0.0) break;
+    alpha = rho_next / r0v;
+    s_ = r_;
+    s_.Axpy(-alpha, v_);
+    result.iterations++;
+    double s_norm = s_.Norm() / b_norm;
+    if (s_norm <= options_.tolerance) {
+      x.Axpy(alpha, p_hat_);
+      Report(result, s_norm);
+      break;
+    }
+    Precondition(preconditioner, s_, s_hat_);
+    a.Apply(s_hat_, t_);
+    double tt = t_.Dot(t_);
+    omega = tt == 0.0 ? 0.0 : t_.Dot(s_) / tt;
+    x.Axpy(alpha, p_hat_);
+    x.Axpy(omega, s_hat_);
+    r_ = s_;
+    r_.Axpy(-omega, t_);
+    if (Report(result, r_.Norm() / b_norm) || omega == 0.0) break;
+    rho = rho_next;
+  }
+  return result;
+}
@@ -0,0 +1,195 @@
+#ifndef S21_SOLVERS_H_
+#define S21_SOLVERS_H_
+
+// Krylov solvers for a * x = b, where a is any S21LinearOperator. Each
+// solver owns its workspace, so after the first Solve() for a given size an
+// iteration allocates nothing, also when the vector kernels run on the
+// executor (provided the operator and preconditioner do not allocate).
+
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+class S21LinearOperator {
+ public:
+  virtual ~S21LinearOperator() {}
+  virtual int size() const = 0;
+  // y = a * x; y already has size() elements
+  virtual void Apply(const S21Vector& x, S21Vector& y) const = 0;
+};
+
+// Keeps a reference to the matrix, which must outlive the operator
+class S21DenseOperator : public S21LinearOperator {
+ public:
+  explicit S21DenseOperator(const S21Matrix& matrix);
+  int size() const override { return matrix_.rows(); }
+  void Apply(const S21Vector& x, S21Vector& y) const override;
+
+ private:
+  const S21Matrix& matrix_;
+};
+
+// Matrix-free operator
+class S21FunctionOperator : public S21LinearOperator {
+ public:
+  using Function = std::function<void(const S21Vector&, S21Vector&)>;
+  S21FunctionOperator(int size, Function apply);
+  int size() const override { return size_; }
+  void Apply(const S21Vector& x, S21Vector& y) const override;
+
+ private:
+  int size_;
+  Function apply_;
+};
+
+// Square matrix in compressed sparse row format with sorted columns
+class S21SparseMatrix : public S21LinearOperator {
+ public:
+  struct Entry {
+    int row, col;
+    double value;
+  };
+
+  // Duplicate entries are summed
+  S21SparseMatrix(int size, std::vector<Entry> entries);
+  // Keeps the nonzero elements of a square matrix
+  explicit S21SparseMatrix(const S21Matrix& dense);
+
+  int size() const override { return size_; }
+  int nonzeros() const { return int(values_.size()); }
+  void Apply(const S21Vector& x, S21Vector& y) const override;
+  // Element (row, col), zero if not stored
+  double operator()(int row, int col) const;
+
+  const std::vector<int>& row_start() const { return row_start_; }
+  const std::vector<int>& columns() const { return columns_; }
+  const std::vector<double>& values() const { return values_; }
+
+ private:
+  int size_;
+  std::vector<int> row_start_;  // size_ + 1 offsets into columns_/values_
+  std::vector<int> columns_;
+  std::vector<double> values_;
+};
+
+class S21Preconditioner {
+ public:
+  virtual ~S21Preconditioner() {}
+  // z = M^-1 * r; z already has the size of r
+  virtual void Apply(const S21Vector& r, S21Vector& z) const = 0;
+};
+
+// M = diag(a)
+class S21JacobiPreconditioner : public S21Preconditioner {
+ public:
+  explicit S21JacobiPreconditioner(const S21Matrix& a);
+  explicit S21JacobiPreconditioner(const S21SparseMatrix& a);
+  void Apply(const S21Vector& r, S21Vector& z) const override;
+
+ private:
+  void Invert();
+  S21Vector inverse_diagonal_;
+};
+
+// Incomplete LU factorization with the sparsity pattern of a
+class S21Ilu0Preconditioner : public S21Preconditioner {
+ public:
+  explicit S21Ilu0Preconditioner(const S21SparseMatrix& a);
+  void Apply(const S21Vector& r, S21Vector& z) const override;
+
+ private:
+  int size_;
+  std::vector<int> row_start_, columns_, diagonal_;
+  std::vector<double> values_;  // Unit L below the diagonal, U from it
+};
+
+struct S21SolverOptions {
+  int max_iterations = 1000;
+  // Stop once ||b - a * x|| <= tolerance * ||b||
+  double tolerance = 1e-10;
+  int restart = 30;  // GMRES only
+  // Called after every iteration with the relative residual
+  std::function<void(int, double)> monitor;
+};
+
+struct S21SolverResult {
+  bool converged = false;
+  int iterations = 0;
+  double residual = 0.0;  // Relative residual at exit
+  // Relative residual before the first and after every iteration; reserved
+  // up front, so recording it does not allocate per iteration
+  std::vector<double> history;
+};
+
+class S21KrylovSolver {
+ public:
+  explicit S21KrylovSolver(const S21SolverOptions& options = {})
+      : options_(options) {}
+  virtual ~S21KrylovSolver() {}
+
+  S21SolverOptions& options() { return options_; }
+
+  // x holds the initial guess (warm start) on entry and the solution on
+  // exit. preconditioner may be null.
+  virtual S21SolverResult Solve(const S21LinearOperator& a,
+                                const S21Vector& b, S21Vector& x,
+                                const S21Preconditioner* preconditioner) = 0;
+  S21SolverResult Solve(const S21LinearOperator& a, const S21Vector& b,
+                        S21Vector& x) {
+    return Solve(a, b, x, nullptr);
+  }
+
+ protected:
+  // Records the residual; true once converged
+  bool Report(S21SolverResult& result, double residual) const;
+  static void Precondition(const S21Preconditioner* preconditioner,
+                           const S21Vector& r, S21Vector& z);
+
+  S21SolverOptions options_;
+};
+
+// Preconditioned conjugate gradient; a and the preconditioner must be
+// symmetric positive definite
+class S21ConjugateGradient : public S21KrylovSolver {
+ public:
+  using S21KrylovSolver::S21KrylovSolver;
+  using S21KrylovSolver::Solve;
+  S21SolverResult Solve(const S21LinearOperator& a, const S21Vector& b,
+                        S21Vector& x,
+                        const S21Preconditioner* preconditioner) override;
+
+ private:
+  S21Vector r_, z_, p_, q_;
+};
+
+// Restarted GMRES(options.restart) with right preconditioning
+class S21Gmres : public S21KrylovSolver {
+ public:
+  using S21KrylovSolver::S21KrylovSolver;
+  using S21KrylovSolver::Solve;
+  S21SolverResult Solve(const S21LinearOperator& a, const S21Vector& b,
+                        S21Vector& x,
+                        const S21Preconditioner* preconditioner) override;
+
+ private:
+  std::vector<S21Vector> basis_;
+  S21Vector r_, w_, z_;
+  std::vector<double> hessenberg_, cs_, sn_, g_, y_;
+};
+
+// Stabilized biconjugate gradient with right preconditioning
+class S21BiCgStab : public S21KrylovSolver {
+ public:
+  using S21KrylovSolver::S21KrylovSolver;
+  using S21KrylovSolver::Solve;
+  S21SolverResult Solve(const S21LinearOperator& a, const S21Vector& b,
+                        S21Vector& x,
+                        const S21Preconditioner* preconditioner) override;
+
+ private:
+  S21Vector r_, r0_, p_, v_, s_, t_, p_hat_, s_hat_;
+};
+
+#endif  // S21_SOLVERS_H_
@@ -0,0 +1,370 @@
+#include "s21_structured.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+void CheckSize(int size) {
+  if (size <= 0) {
+    throw std::runtime_error(
+        "Error: The size of the matrix must be greater than zero");
+  }
+}
+
+S21Matrix Zeros(int rows, int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    double* row = result.mutable_row(i);
+    std::fill(row, row + cols, 0.0);
+  }
+  return result;
+}
+
+void CheckMul(int size, const S21Matrix& other) {
+  if (size != other.rows()) {
+    throw std::runtime_error(
+        "Number of columns in the first matrix should match number of rows in "
+        "the second matrix.");
+  }
+}
+
+}  // namespace
+
+// S21DiagonalMatrix
+
+S21DiagonalMatrix::S21DiagonalMatrix(int size) {
+  CheckSize(size);
+  diagonal_.assign(size, 0.0);
+}
+
+S21DiagonalMatrix::S21DiagonalMatrix(const std::vector<double>& diagonal)
+    : diagonal_(diagonal) {
+  CheckSize(int(diagonal.size()));
+}
+
+double& S21DiagonalMatrix::operator()(int i) {
+  if (i < 0 || i >= size()) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  return diagonal_[i];
+}
+
+double S21DiagonalMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= size() || col < 0 || col >= size()) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  return row == col ? diagonal_[row] : 0.0;
+}
+
+double S21DiagonalMatrix::Determinant() const {
+  double result = 1.0;
+  for (double value : diagonal_) result *= value;
+  return result;
+}
+
+S21DiagonalMatrix S21DiagonalMatrix::InverseMatrix() const {
+  S21DiagonalMatrix result(size());
+  for (int i = 0; i < size(); i++) {
+    if (diagonal_[i] == 0.0) {
+      throw std::runtime_error("Error: The matrix is not invertible");
+    }
+    result.diagonal_[i] = 1.0 / diagonal_[i];
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::MulMatrix(const S21Matrix& other) const {
+  CheckMul(size(), other);
+  S21Matrix result(size(), other.cols());
+  for (int i = 0; i < size(); i++) {
+    const double* src = other.row(i);
+    double* dst = result.mutable_row(i);
+    for (int j = 0; j < other.cols(); j++) dst[j] = diagonal_[i] * src[j];
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::ToDense() const {
+  S21Matrix result = Zeros(size(), size());
+  for (int i = 0; i < size(); i++) result.mutable_row(i)[i] = diagonal_[i];
+  return result;
+}
+
+// S21TriangularMatrix
+
+S21TriangularMatrix::S21TriangularMatrix(int size, Uplo uplo)
+    : size_(size), uplo_(uplo) {
+  CheckSize(size);
+  packed_.assign(size_t(size) * (size + 1) / 2, 0.0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix& dense, Uplo uplo)
+    : S21TriangularMatrix(dense.rows(), uplo) {
+  if (dense.rows() != dense.cols()) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+  for (int i = 0; i < size_; i++) {
+    const double* row = dense.row(i);
+    int begin = uplo_ == kLower ? 0 : i;
+    int end = uplo_ == kLower ? i + 1 : size_;
+    for (int j = begin; j < end; j++) packed_[Index(i, j)] = row[j];
+  }
+}
+
+bool S21TriangularMatrix::Stored(int row, int col) const {
+  return uplo_ == kLower ? col <= row : row <= col;
+}
+
+size_t S21TriangularMatrix::Index(int row, int col) const {
+  return uplo_ == kLower ? size_t(row) * (row + 1) / 2 + col
+                         : size_t(col) * (col + 1) / 2 + row;
+}
+
+void S21TriangularMatrix::CheckIndex(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+}
+
+double& S21TriangularMatrix::operator()(int row, int col) {
+  CheckIndex(row, col);
+  if (!Stored(row, col)) {
+    throw std::runtime_error("Error: Index is outside the stored triangle");
+  }
+  return packed_[Index(row, col)];
+}
+
+double S21TriangularMatrix::operator()(int row, int col) const {
+  CheckIndex(row, col);
+  return Stored(row, col) ? packed_[Index(row, col)] : 0.0;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  double result = 1.0;
+  for (int i = 0; i < size_; i++) result *= packed_[Index(i, i)];
+  return result;
+}
+
+// Column k of the inverse solves this * x = e_k; it shares the triangle of
+// this, so only the stored part is computed
+S21TriangularMatrix S21TriangularMatrix::InverseMatrix() const {
+  S21TriangularMatrix result(size_, uplo_);
+  for (int i = 0; i < size_; i++) {
+    if (packed_[Index(i, i)] == 0.0) {
+      throw std::runtime_error("Error: The matrix is not invertible");
+    }
+  }
+  for (int k = 0; k < size_; k++) {
+    if (uplo_ == kLower) {
+      for (int i = k; i < size_; i++) {
+        double sum = i == k ? 1.0 : 0.0;
+        for (int j = k; j < i; j++) {
+          sum -= packed_[Index(i, j)] * result.packed_[Index(j, k)];
+        }
+        result.packed_[Index(i, k)] = sum / packed_[Index(i, i)];
+      }
+    } else {
+      for (int i = k; i >= 0; i--) {
+        double sum = i == k ? 1.0 : 0.0;
+        for (int j = i + 1; j <= k; j++) {
+          sum -= packed_[Index(i, j)] * result.packed_[Index(j, k)];
+        }
+        result.packed_[Index(i, k)] = sum / packed_[Index(i, i)];
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::MulMatrix(const S21Matrix& other) const {
+  CheckMul(size_, other);
+  S21Matrix result = Zeros(size_, other.cols());
+  for (int i = 0; i < size_; i++) {
+    double* dst = result.mutable_row(i);
+    int begin = uplo_ == kLower ? 0 : i;
+    int end = uplo_ == kLower ? i + 1 : size_;
+    for (int k = begin; k < end; k++) {
+      double a = packed_[Index(i, k)];
+      const double* src = other.row(k);
+      for (int j = 0; j < other.cols(); j++) dst[j] += a * src[j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix& rhs) const {
+  CheckMul(size_, rhs);
+  for (int i = 0; i < size_; i++) {
+    if (packed_[Index(i, i)] == 0.0) {
+      throw std::runtime_error("Error: The matrix is not invertible");
+    }
+  }
+  S21Matrix result(rhs);
+  int cols = rhs.cols();
+  for (int step = 0; step < size_; step++) {
+    int i = uplo_ == kLower ? step : size_ - 1 - step;
+    double* x = result.mutable_row(i);
+    int begin = uplo_ == kLower ? 0 : i + 1;
+    int end = uplo_ == kLower ? i : size_;
+    for (int k = begin; k < end; k++) {
+      double a = packed_[Index(i, k)];
+      const double* solved = result.row(k);
+      for (int j = 0; j < cols; j++) x[j] -= a * solved[j];
+    }
+    double pivot = packed_[Index(i, i)];
+    for (int j = 0; j < cols; j++) x[j] /= pivot;
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::ToDense() const {
+  S21Matrix result = Zeros(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    double* row = result.mutable_row(i);
+    for (int j = 0; j < size_; j++) {
+      if (Stored(i, j)) row[j] = packed_[Index(i, j)];
+    }
+  }
+  return result;
+}
+
+// S21SymmetricMatrix
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  CheckSize(size);
+  packed_.assign(size_t(size) * (size + 1) / 2, 0.0);
+}
+
+size_t S21SymmetricMatrix::Index(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  if (col > row) std::swap(row, col);
+  return size_t(row) * (row + 1) / 2 + col;
+}
+
+double& S21SymmetricMatrix::operator()(int row, int col) {
+  return packed_[Index(row, col)];
+}
+
+double S21SymmetricMatrix::operator()(int row, int col) const {
+  return packed_[Index(row, col)];
+}
+
+void S21SymmetricMatrix::RankKUpdate(const S21Matrix& a, double alpha,
+                                     double beta) {
+  if (a.rows() != size_) {
+    throw std::runtime_error(
+        "Error: The update must have as many rows as the matrix");
+  }
+  int k = a.cols();
+  double* c = packed_.data();
+  for (int i = 0; i < size_; i++) {
+    const double* ai = a.row(i);
+    double* ci = c + size_t(i) * (i + 1) / 2;
+    for (int j = 0; j <= i; j++) {
+      const double* aj = a.row(j);
+      double dot = 0.0;
+      for (int l = 0; l < k; l++) dot += ai[l] * aj[l];
+      double& element = ci[j];
+      element = alpha * dot + (beta == 0.0 ? 0.0 : beta * element);
+    }
+  }
+}
+
+S21Matrix S21SymmetricMatrix::MulMatrix(const S21Matrix& other) const {
+  CheckMul(size_, other);
+  S21Matrix result = Zeros(size_, other.cols());
+  int cols = other.cols();
+  // Every stored off-diagonal element contributes to two output rows
+  for (int i = 0; i < size_; i++) {
+    double* dst_i = result.mutable_row(i);
+    const double* src_i = other.row(i);
+    const double* packed_i = packed_.data() + size_t(i) * (i + 1) / 2;
+    for (int k = 0; k < i; k++) {
+      double a = packed_i[k];
+      const double* src_k = other.row(k);
+      double* dst_k = result.mutable_row(k);
+      for (int j = 0; j < cols; j++) {
+        dst_i[j] += a * src_k[j];
+        dst_k[j] += a * src_i[j];
+      }
+    }
+    double d = packed_i[i];
+    for (int j = 0; j < cols; j++) dst_i[j] += d * src_i[j];
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::ToDense() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    double* row = result.mutable_row(i);
+    for (int j = 0; j < size_; j++) row[j] = packed_[Index(i, j)];
+  }
+  return result;
+}
+
+// S21BandMatrix
+
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  CheckSize(size);
+  if (lower < 0 || upper < 0 || lower >= size || upper >= size) {
+    throw std::runtime_error("Error: Invalid matrix bandwidth");
+  }
+  band_.assign(size_t(lower + upper + 1) * size, 0.0);
+}
+
+bool S21BandMatrix::Stored(int row, int col) const {
+  return col - row <= upper_ && row - col <= lower_;
+}
+
+double& S21BandMatrix::operator()(int row, int col) {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  if (!Stored(row, col)) {
+    throw std::runtime_error("Error: Index is outside the band");
+  }
+  return band_[size_t(upper_ + row - col) * size_ + col];
+}
+
+double S21BandMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::runtime_error("Error: Index is outside the matrix");
+  }
+  return Stored(row, col) ? band_[size_t(upper_ + row - col) * size_ + col]
+                          : 0.0;
+}
+
+S21Matrix S21BandMatrix::MulMatrix(const S21Matrix& other) const {
+  CheckMul(size_, other);
+  S21Matrix result = Zeros(size_, other.cols());
+  int cols = other.cols();
+  for (int i = 0; i < size_; i++) {
+    double* dst = result.mutable_row(i);
+    int begin = std::max(0, i - lower_);
+    int end = std::min(size_ - 1, i + upper_);
+    for (int k = begin; k <= end; k++) {
+      double a = band_[size_t(upper_ + i - k) * size_ + k];
+      const double* src = other.row(k);
+      for (int j = 0; j < cols; j++) dst[j] += a * src[j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21BandMatrix::ToDense() const {
+  S21Matrix result = Zeros(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    double* row = result.mutable_row(i);
+    int begin = std::max(0, i - lower_);
+    int end = std::min(size_ - 1, i + upper_);
+    for (int j = begin; j <= end; j++) {
+      row[j] = band_[size_t(upper_ + i - j) * size_ + j];
+    }
+  }
+  return result;
+}
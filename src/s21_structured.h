@@ -0,0 +1,117 @@
+#ifndef S21_STRUCTURED_H_
+#define S21_STRUCTURED_H_
+
+// Structured square matrices with packed storage. Memory and the cost of each
+// kernel scale with the stored part only; ToDense() converts to S21Matrix.
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+class S21DiagonalMatrix {
+ public:
+  explicit S21DiagonalMatrix(int size);
+  explicit S21DiagonalMatrix(const std::vector<double>& diagonal);
+
+  int size() const { return int(diagonal_.size()); }
+
+  double& operator()(int i);
+  double operator()(int row, int col) const;
+
+  double Determinant() const;
+  S21DiagonalMatrix InverseMatrix() const;
+  // this * other, O(size * other.cols())
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix ToDense() const;
+
+ private:
+  std::vector<double> diagonal_;
+};
+
+// Row-packed triangle: element (i, j) of a lower matrix is at i(i+1)/2 + j,
+// of an upper matrix at the same offset of (j, i)
+class S21TriangularMatrix {
+ public:
+  enum Uplo { kLower, kUpper };
+
+  S21TriangularMatrix(int size, Uplo uplo);
+  // Takes the uplo triangle of a square matrix, ignoring the rest
+  S21TriangularMatrix(const S21Matrix& dense, Uplo uplo);
+
+  int size() const { return size_; }
+  Uplo uplo() const { return uplo_; }
+
+  // Element inside the stored triangle
+  double& operator()(int row, int col);
+  // Any element, zero outside the triangle
+  double operator()(int row, int col) const;
+
+  double Determinant() const;
+  S21TriangularMatrix InverseMatrix() const;
+  // this * other, half the flops of a dense product
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  // Solves this * X = rhs by forward or back substitution, O(size^2) per
+  // right-hand side column
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  S21Matrix ToDense() const;
+
+ private:
+  bool Stored(int row, int col) const;
+  size_t Index(int row, int col) const;
+  void CheckIndex(int row, int col) const;
+
+  int size_;
+  Uplo uplo_;
+  std::vector<double> packed_;
+};
+
+// Stores the lower triangle, row-packed as in S21TriangularMatrix
+class S21SymmetricMatrix {
+ public:
+  explicit S21SymmetricMatrix(int size);
+
+  int size() const { return size_; }
+
+  // Both (i, j) and (j, i) refer to the same element
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+  // Symmetric rank-k update: this = alpha * a * a^T + beta * this, where a
+  // is size x k. Only the stored triangle is computed.
+  void RankKUpdate(const S21Matrix& a, double alpha, double beta);
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix ToDense() const;
+
+ private:
+  size_t Index(int row, int col) const;
+
+  int size_;
+  std::vector<double> packed_;
+};
+
+// Band of `lower` sub- and `upper` super-diagonals, stored by diagonal:
+// element (i, j) lives at band_[(upper + i - j) * size + j]
+class S21BandMatrix {
+ public:
+  S21BandMatrix(int size, int lower, int upper);
+
+  int size() const { return size_; }
+  int lower() const { return lower_; }
+  int upper() const { return upper_; }
+
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+  // this * other, O(size * (lower + upper + 1) * other.cols())
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix ToDense() const;
+
+ private:
+  bool Stored(int row, int col) const;
+
+  int size_, lower_, upper_;
+  std::vector<double> band_;
+};
+
+#endif  // S21_STRUCTURED_H_
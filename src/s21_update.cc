@@ -0,0 +1,283 @@
+#include "s21_update.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_lu.h"
+
+namespace {
+
+void CheckSize(int size, const S21Vector& x) {
+  if (x.size() != size) {
+    throw std::runtime_error(
+        "Error: The matrix and vector dimensions do not match");
+  }
+}
+
+void CheckSquare(const S21Matrix& a) {
+  if (a.rows() != a.cols() || a.rows() == 0) {
+    throw std::runtime_error("Error: The matrix must be square");
+  }
+}
+
+S21Matrix Zero(int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; i++) {
+    std::fill(result.mutable_row(i), result.mutable_row(i) + size, 0.0);
+  }
+  return result;
+}
+
+}  // namespace
+
+// S21UpdatableInverse
+
+S21UpdatableInverse::S21UpdatableInverse(const S21Matrix& a) {
+  CheckSquare(a);
+  S21Matrix source(a);
+  inverse_ = source.InverseMatrix();
+  determinant_ = source.Determinant();  // Reuses the LU of InverseMatrix()
+  au_.Resize(a.rows());
+  va_.Resize(a.rows());
+}
+
+void S21UpdatableInverse::Update(const S21Vector& u, const S21Vector& v) {
+  int n = size();
+  CheckSize(n, u);
+  CheckSize(n, v);
+  au_.Gemv(1.0, inverse_, u, 0.0);
+  va_.Fill(0.0);
+  double* va = va_.data();
+  const double* pv = v.data();
+  for (int i = 0; i < n; i++) {
+    const double* row = inverse_.row(i);
+    for (int j = 0; j < n; j++) va[j] += pv[i] * row[j];
+  }
+  double dot = v.Dot(au_);
+  double factor = 1.0 + dot;
+  if (S21NegligiblePivot(factor, 1.0 + std::fabs(dot), n)) {
+    throw std::runtime_error("Error: The matrix is not invertible");
+  }
+  // (a + u v^T)^-1 = a^-1 - a^-1 u v^T a^-1 / (1 + v^T a^-1 u)
+  const double* au = au_.data();
+  for (int i = 0; i < n; i++) {
+    double* row = inverse_.mutable_row(i);
+    double scale = au[i] / factor;
+    for (int j = 0; j < n; j++) row[j] -= scale * va[j];
+  }
+  determinant_ *= factor;
+}
+
+void S21UpdatableInverse::Update(const S21Matrix& u, const S21Matrix& v) {
+  int n = size();
+  if (u.rows() != n || v.rows() != n || u.cols() != v.cols()) {
+    throw std::runtime_error(
+        "Error: The update must be two size x k matrices");
+  }
+  // (a + U V^T)^-1 = a^-1 - a^-1 U C^-1 V^T a^-1, C = I + V^T a^-1 U, and
+  // det(a + U V^T) = det(C) det(a)
+  S21Matrix au = inverse_ * u;
+  S21Matrix vt = v.Transpose();
+  S21Matrix capacitance = vt * au;
+  for (int i = 0; i < capacitance.rows(); i++) {
+    capacitance.mutable_row(i)[i] += 1.0;
+  }
+  // C has no inverse exactly when a + U V^T has none, by the same rule
+  S21Matrix capacitance_inverse;
+  if (capacitance.TryInverseMatrix(capacitance_inverse) != OK) {
+    throw std::runtime_error("Error: The matrix is not invertible");
+  }
+  double factor = capacitance.Determinant();  // Reuses the LU
+  inverse_ -= au * capacitance_inverse * (vt * inverse_);
+  determinant_ *= factor;
+}
+
+void S21UpdatableInverse::Solve(const S21Vector& b, S21Vector& x) const {
+  CheckSize(size(), b);
+  x.Resize(size());
+  x.Gemv(1.0, inverse_, b, 0.0);
+}
+
+// S21LuFactorization
+
+S21LuFactorization::S21LuFactorization(const S21Matrix& a)
+    : lu_(a), backup_(a.rows(), a.cols()), permutation_(a.rows()), sign_(1) {
+  CheckSquare(a);
+  int n = a.rows();
+  // Same elimination and singularity rule as S21Matrix::InverseMatrix()
+  S21LuStatus status = S21LuFactorize(lu_.mutable_row(0), n,
+                                      permutation_.data(), &sign_,
+                                      [] { return false; });
+  if (status != kS21LuRegular) {
+    throw std::runtime_error("Error: The matrix is not invertible");
+  }
+  x_.Resize(n);
+  y_.Resize(n);
+}
+
+S21Matrix S21LuFactorization::Lower() const {
+  S21Matrix result = Zero(size());
+  for (int i = 0; i < size(); i++) {
+    std::copy(lu_.row(i), lu_.row(i) + i, result.mutable_row(i));
+    result.mutable_row(i)[i] = 1.0;
+  }
+  return result;
+}
+
+S21Matrix S21LuFactorization::Upper() const {
+  S21Matrix result = Zero(size());
+  for (int i = 0; i < size(); i++) {
+    std::copy(lu_.row(i) + i, lu_.row(i) + size(), result.mutable_row(i) + i);
+  }
+  return result;
+}
+
+double S21LuFactorization::Determinant() const {
+  double result = sign_;
+  for (int i = 0; i < size(); i++) result *= lu_.row(i)[i];
+  return result;
+}
+
+// Bennett's algorithm on L U + (P u) v^T: eliminates the update one pivot at
+// a time, touching each element of L and U once
+void S21LuFactorization::Update(const S21Vector& u, const S21Vector& v) {
+  int n = size();
+  CheckSize(n, u);
+  CheckSize(n, v);
+  for (int i = 0; i < n; i++) {
+    std::copy(lu_.row(i), lu_.row(i) + n, backup_.mutable_row(i));
+  }
+  double* x = x_.data();
+  double* y = y_.data();
+  for (int i = 0; i < n; i++) x[i] = u.data()[permutation_[i]];
+  std::copy(v.data(), v.data() + n, y);
+  for (int k = 0; k < n; k++) {
+    double* rk = lu_.mutable_row(k);
+    double change = x[k] * y[k];
+    double scale = std::fabs(rk[k]) + std::fabs(change);
+    rk[k] += change;
+    if (S21NegligiblePivot(rk[k], scale, n)) {
+      std::swap(lu_, backup_);
+      throw std::runtime_error("Error: Zero pivot, refactorize the matrix");
+    }
+    y[k] /= rk[k];
+    for (int i = k + 1; i < n; i++) {
+      double* ri = lu_.mutable_row(i);
+      x[i] -= x[k] * ri[k];
+      ri[k] += y[k] * x[i];
+    }
+    for (int j = k + 1; j < n; j++) {
+      rk[j] += x[k] * y[j];
+      y[j] -= y[k] * rk[j];
+    }
+  }
+}
+
+void S21LuFactorization::Solve(const S21Vector& b, S21Vector& x) const {
+  int n = size();
+  CheckSize(n, b);
+  x.Resize(n);
+  double* px = x.data();
+  for (int i = 0; i < n; i++) {
+    const double* ri = lu_.row(i);
+    double sum = b.data()[permutation_[i]];
+    for (int k = 0; k < i; k++) sum -= ri[k] * px[k];
+    px[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const double* ri = lu_.row(i);
+    double sum = px[i];
+    for (int k = i + 1; k < n; k++) sum -= ri[k] * px[k];
+    px[i] = sum / ri[i];
+  }
+}
+
+// S21CholeskyFactorization
+
+S21CholeskyFactorization::S21CholeskyFactorization(const S21Matrix& a)
+    : lower_(Zero(a.rows())), work_(a.rows()) {
+  CheckSquare(a);
+  int n = a.rows();
+  for (int i = 0; i < n; i++) {
+    double* li = lower_.mutable_row(i);
+    for (int j = 0; j <= i; j++) {
+      const double* lj = lower_.row(j);
+      double sum = a.row(i)[j];
+      for (int k = 0; k < j; k++) sum -= li[k] * lj[k];
+      if (i > j) {
+        li[j] = sum / lj[j];
+      } else if (sum > 0.0) {
+        li[i] = std::sqrt(sum);
+      } else {
+        throw std::runtime_error(
+            "Error: The matrix is not positive definite");
+      }
+    }
+  }
+}
+
+double S21CholeskyFactorization::Determinant() const {
+  double result = 1.0;
+  for (int i = 0; i < size(); i++) result *= lower_.row(i)[i];
+  return result * result;
+}
+
+void S21CholeskyFactorization::Update(const S21Vector& x) {
+  CheckSize(size(), x);
+  RankOne(x, 1.0);
+}
+
+// a - x x^T stays positive definite exactly when ||L^-1 x|| < 1
+void S21CholeskyFactorization::Downdate(const S21Vector& x) {
+  CheckSize(size(), x);
+  double* p = work_.data();
+  for (int i = 0; i < size(); i++) {
+    const double* li = lower_.row(i);
+    double sum = x.data()[i];
+    for (int k = 0; k < i; k++) sum -= li[k] * p[k];
+    p[i] = sum / li[i];
+  }
+  if (work_.Dot(work_) >= 1.0) {
+    throw std::runtime_error("Error: The matrix is not positive definite");
+  }
+  RankOne(x, -1.0);
+}
+
+// Applies one (hyperbolic, for a downdate) rotation per column
+void S21CholeskyFactorization::RankOne(const S21Vector& x, double sign) {
+  int n = size();
+  double* w = work_.data();
+  std::copy(x.data(), x.data() + n, w);
+  for (int k = 0; k < n; k++) {
+    double* lk = lower_.mutable_row(k);
+    double r = std::sqrt(lk[k] * lk[k] + sign * w[k] * w[k]);
+    double c = r / lk[k];
+    double s = w[k] / lk[k];
+    lk[k] = r;
+    for (int i = k + 1; i < n; i++) {
+      double* li = lower_.mutable_row(i);
+      li[k] = (li[k] + sign * s * w[i]) / c;
+      w[i] = c * w[i] - s * li[k];
+    }
+  }
+}
+
+void S21CholeskyFactorization::Solve(const S21Vector& b, S21Vector& x) const {
+  int n = size();
+  CheckSize(n, b);
+  x.Resize(n);
+  double* px = x.data();
+  for (int i = 0; i < n; i++) {
+    const double* li = lower_.row(i);
+    double sum = b.data()[i];
+    for (int k = 0; k < i; k++) sum -= li[k] * px[k];
+    px[i] = sum / li[i];
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    double sum = px[i];
+    for (int k = i + 1; k < n; k++) sum -= lower_.row(k)[i] * px[k];
+    px[i] = sum / lower_.row(i)[i];
+  }
+}
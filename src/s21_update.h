@@ -0,0 +1,90 @@
+#ifndef S21_UPDATE_H_
+#define S21_UPDATE_H_
+
+// Factorizations and inverses that follow a matrix changing by low-rank
+// terms. Setup is O(n^3) once; every rank-one update after that is O(n^2).
+// Rounding errors accumulate across updates, so long-running callers should
+// rebuild from the current matrix now and then.
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+// Inverse and determinant of a, kept current through a += u * v^T
+class S21UpdatableInverse {
+ public:
+  // Throws if a is not square or not invertible
+  explicit S21UpdatableInverse(const S21Matrix& a);
+
+  int size() const { return inverse_.rows(); }
+  const S21Matrix& inverse() const { return inverse_; }
+  double determinant() const { return determinant_; }
+
+  // Sherman-Morrison and the matrix determinant lemma, O(n^2). Throws and
+  // leaves the state unchanged if the updated matrix is singular.
+  void Update(const S21Vector& u, const S21Vector& v);
+  // Woodbury for size x k matrices u and v, O(n^2 k + k^3)
+  void Update(const S21Matrix& u, const S21Matrix& v);
+  // x = a^-1 * b, O(n^2)
+  void Solve(const S21Vector& b, S21Vector& x) const;
+
+ private:
+  S21Matrix inverse_;
+  double determinant_;
+  S21Vector au_, va_;  // a^-1 * u and v^T * a^-1
+};
+
+// Partial pivoting LU, P * a = L * U, kept current through a += u * v^T by
+// Bennett's algorithm. Updates keep the row order chosen by the initial
+// pivoting, so a pivot can shrink; one that cancels to rounding level
+// throws and leaves the factorization unchanged, and the caller should
+// refactorize. Singular means the same as for S21Matrix (see s21_lu.h).
+class S21LuFactorization {
+ public:
+  // Throws if a is not square or singular
+  explicit S21LuFactorization(const S21Matrix& a);
+
+  int size() const { return lu_.rows(); }
+  // Row i of P * a is row permutation()[i] of a
+  const std::vector<int>& permutation() const { return permutation_; }
+  S21Matrix Lower() const;  // Unit diagonal
+  S21Matrix Upper() const;
+  double Determinant() const;  // O(n)
+
+  void Update(const S21Vector& u, const S21Vector& v);
+  void Solve(const S21Vector& b, S21Vector& x) const;
+
+ private:
+  S21Matrix lu_;  // L below the diagonal, U from it
+  S21Matrix backup_;
+  std::vector<int> permutation_;
+  int sign_;
+  S21Vector x_, y_;
+};
+
+// a = L * L^T for symmetric positive definite a, kept current through
+// a += x * x^T and a -= x * x^T
+class S21CholeskyFactorization {
+ public:
+  // Reads the lower triangle of a. Throws if a is not positive definite.
+  explicit S21CholeskyFactorization(const S21Matrix& a);
+
+  int size() const { return lower_.rows(); }
+  const S21Matrix& lower() const { return lower_; }  // Zero above diagonal
+  double Determinant() const;
+
+  void Update(const S21Vector& x);
+  // Throws and leaves the factor unchanged if a - x * x^T is not positive
+  // definite
+  void Downdate(const S21Vector& x);
+  void Solve(const S21Vector& b, S21Vector& x) const;
+
+ private:
+  void RankOne(const S21Vector& x, double sign);
+
+  S21Matrix lower_;
+  S21Vector work_;
+};
+
+#endif  // S21_UPDATE_H_
@@ -0,0 +1,168 @@
+#include "s21_vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_executor.h"
+
+namespace {
+
+// Below this many elements (or matrix entries for Gemv) kernels stay on the
+// calling thread
+const int kParallelMin = 1 << 15;
+// Large reductions are split into this many fixed parts, whatever the
+// number of threads, so the result does not depend on the machine
+const int kParts = 64;
+
+void CheckSize(int size, int other) {
+  if (size != other) {
+    throw std::runtime_error("Error: The vectors must have the same size");
+  }
+}
+
+// Four independent accumulators let the compiler vectorize the loop without
+// reassociating floating point sums
+double DotKernel(const double* x, const double* y, int n) {
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += x[i] * y[i];
+    s1 += x[i + 1] * y[i + 1];
+    s2 += x[i + 2] * y[i + 2];
+    s3 += x[i + 3] * y[i + 3];
+  }
+  for (; i < n; i++) s0 += x[i] * y[i];
+  return (s0 + s1) + (s2 + s3);
+}
+
+double ParallelDot(const double* x, const double* y, int n) {
+  if (n < kParallelMin) return DotKernel(x, y, n);
+  double partial[kParts];
+  int step = (n + kParts - 1) / kParts;
+  S21Executor::Default().ParallelFor(0, kParts, 1, [&](int begin, int end) {
+    for (int part = begin; part < end; part++) {
+      int first = std::min(n, part * step);
+      int last = std::min(n, first + step);
+      partial[part] = DotKernel(x + first, y + first, last - first);
+    }
+  });
+  double result = 0.0;
+  for (double value : partial) result += value;
+  return result;
+}
+
+// Runs body over [0, n) in parallel chunks when n is large
+template <class F>
+void ForEach(int n, F body) {
+  if (n < kParallelMin) {
+    body(0, n);
+  } else {
+    S21Executor::Default().ParallelFor(0, n, kParallelMin / 2, body);
+  }
+}
+
+}  // namespace
+
+S21Vector::S21Vector(int size, double value) {
+  if (size < 0) {
+    throw std::runtime_error(
+        "Error: The size of the vector must not be negative");
+  }
+  data_.assign(size, value);
+}
+
+S21Vector::S21Vector(std::initializer_list<double> values) : data_(values) {}
+
+double& S21Vector::operator()(int i) {
+  if (i < 0 || i >= size()) {
+    throw std::runtime_error("Error: Index is outside the vector");
+  }
+  return data_[i];
+}
+
+const double& S21Vector::operator()(int i) const {
+  if (i < 0 || i >= size()) {
+    throw std::runtime_error("Error: Index is outside the vector");
+  }
+  return data_[i];
+}
+
+void S21Vector::Fill(double value) {
+  std::fill(data_.begin(), data_.end(), value);
+}
+
+void S21Vector::Resize(int size) {
+  if (size < 0) {
+    throw std::runtime_error(
+        "Error: The size of the vector must not be negative");
+  }
+  data_.resize(size);
+}
+
+double S21Vector::Dot(const S21Vector& other) const {
+  CheckSize(size(), other.size());
+  return ParallelDot(data(), other.data(), size());
+}
+
+double S21Vector::Norm() const {
+  return std::sqrt(ParallelDot(data(), data(), size()));
+}
+
+void S21Vector::Axpy(double alpha, const S21Vector& x) {
+  CheckSize(size(), x.size());
+  double* y = data();
+  const double* src = x.data();
+  ForEach(size(), [=](int begin, int end) {
+    for (int i = begin; i < end; i++) y[i] += alpha * src[i];
+  });
+}
+
+void S21Vector::Xpby(const S21Vector& x, double beta) {
+  CheckSize(size(), x.size());
+  double* y = data();
+  const double* src = x.data();
+  ForEach(size(), [=](int begin, int end) {
+    for (int i = begin; i < end; i++) y[i] = src[i] + beta * y[i];
+  });
+}
+
+void S21Vector::MulNumber(double num) {
+  double* y = data();
+  ForEach(size(), [=](int begin, int end) {
+    for (int i = begin; i < end; i++) y[i] *= num;
+  });
+}
+
+void S21Vector::Gemv(double alpha, const S21Matrix& a, const S21Vector& x,
+                     double beta) {
+  if (a.cols() != x.size() || a.rows() != size()) {
+    throw std::runtime_error(
+        "Error: The matrix and vector dimensions do not match");
+  }
+  if (&x == this) {
+    throw std::runtime_error("Error: Gemv cannot run in place");
+  }
+  double* y = data();
+  const double* src = x.data();
+  int cols = a.cols();
+  auto rows = [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      double value = alpha * DotKernel(a.row(i), src, cols);
+      y[i] = beta == 0.0 ? value : value + beta * y[i];
+    }
+  };
+  long long work = (long long)a.rows() * cols;
+  if (work < kParallelMin) {
+    rows(0, a.rows());
+  } else {
+    int grain = std::max(1, kParallelMin / 2 / std::max(cols, 1));
+    S21Executor::Default().ParallelFor(0, a.rows(), grain, rows);
+  }
+}
+
+S21Vector operator*(const S21Matrix& a, const S21Vector& x) {
+  S21Vector result(a.rows());
+  result.Gemv(1.0, a, x, 0.0);
+  return result;
+}
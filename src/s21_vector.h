@@ -0,0 +1,52 @@
+#ifndef S21_VECTOR_H_
+#define S21_VECTOR_H_
+
+#include <initializer_list>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Dense vector in one contiguous allocation, with the BLAS level 1 and 2
+// kernels the iterative solvers are built from. Kernels run on
+// S21Executor::Default() once the operands are large enough to pay for it.
+class S21Vector {
+ public:
+  S21Vector() {}
+  explicit S21Vector(int size, double value = 0.0);
+  S21Vector(std::initializer_list<double> values);
+
+  int size() const { return int(data_.size()); }
+  double* data() { return data_.data(); }
+  const double* data() const { return data_.data(); }
+
+  // Indexation by element
+  double& operator()(int i);
+  const double& operator()(int i) const;
+
+  void Fill(double value);
+  // New elements are zero; no allocation if size <= capacity
+  void Resize(int size);
+
+  double Dot(const S21Vector& other) const;
+  double Norm() const;  // Euclidean norm
+  // this += alpha * x
+  void Axpy(double alpha, const S21Vector& x);
+  // this = x + beta * this
+  void Xpby(const S21Vector& x, double beta);
+  void MulNumber(double num);
+  // this = alpha * a * x + beta * this; with beta == 0 the old contents are
+  // ignored, so this may be uninitialized
+  void Gemv(double alpha, const S21Matrix& a, const S21Vector& x,
+            double beta);
+
+  bool operator==(const S21Vector& other) const {
+    return data_ == other.data_;
+  }
+
+ private:
+  std::vector<double> data_;
+};
+
+S21Vector operator*(const S21Matrix& a, const S21Vector& x);
+
+#endif  // S21_VECTOR_H_